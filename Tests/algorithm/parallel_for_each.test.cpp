@@ -0,0 +1,199 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <benchmark.tests.hpp>
+#include <comparison.tests.hpp>
+#include <print.tests.hpp>
+#include <require.tests.hpp>
+#include <template.tests.hpp>
+
+#include <algorithm/parallel_for_each>
+
+#if defined(_MSC_VER)
+#   pragma warning(push, 0)
+#endif
+
+#include <atomic>
+#include <utility>
+
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+
+TEST(parallel_for_each, function, blocks) {
+    // A small array fits in a single block.
+    gtl::array_nd<float, 0, 0> array_nd_small(10ull, 10ull);
+    REQUIRE(gtl::parallel_blocks::count(array_nd_small) == 1);
+
+    // Column-major blocks take whole first dimensions and split the last.
+    gtl::array_nd<float, 0, 0, 0> array_nd_column(64ull, 64ull, 64ull);
+    const gtl::parallel_blocks::split<gtl::array_nd<float, 0, 0, 0>> column_blocks(array_nd_column);
+    REQUIRE(column_blocks.block_sizes[0] == 64);
+    REQUIRE(column_blocks.block_sizes[1] == 64);
+    REQUIRE(column_blocks.block_sizes[2] == 16);
+    REQUIRE(column_blocks.block_total == 4);
+
+    // Row-major blocks take whole last dimensions and split the first.
+    gtl::layout_array_nd<float, gtl::array_layout_row_major, 0, 0, 0> array_nd_row(64ull, 64ull, 64ull);
+    const gtl::parallel_blocks::split<gtl::layout_array_nd<float, gtl::array_layout_row_major, 0, 0, 0>> row_blocks(array_nd_row);
+    REQUIRE(row_blocks.block_sizes[0] == 16);
+    REQUIRE(row_blocks.block_sizes[2] == 64);
+
+    // Tiled blocks are whole tiles.
+    gtl::layout_array_nd<float, gtl::array_layout_tiled<8>, 0, 0> array_nd_tiled(1000ull, 1000ull);
+    const gtl::parallel_blocks::split<gtl::layout_array_nd<float, gtl::array_layout_tiled<8>, 0, 0>> tiled_blocks(array_nd_tiled);
+    REQUIRE(tiled_blocks.block_sizes[0] == 1000);
+    REQUIRE((tiled_blocks.block_sizes[1] % 8) == 0);
+    REQUIRE(tiled_blocks.block_sizes[0] * tiled_blocks.block_sizes[1] * sizeof(float) <= gtl::parallel_blocks::block_bytes);
+}
+
+TEST(parallel_for_each, evaluation, for_each) {
+    testbench::test_template<testbench::type_collection<gtl::array_layout_column_major, gtl::array_layout_row_major, gtl::array_layout_tiled<8>, gtl::array_layout_morton>>(
+        [](auto test_layout)->void {
+            using layout_type = typename decltype(test_layout)::type;
+            gtl::thread_pool thread_pool(3);
+
+            gtl::layout_array_nd<unsigned long long int, layout_type, 0, 0, 0> array_nd(67ull, 129ull, 33ull);
+            gtl::parallel_for_each(array_nd, [](const unsigned long long int (&indexes)[3], unsigned long long int& value) {
+                value = indexes[0] + indexes[1] * 1000 + indexes[2] * 1000000;
+            }, thread_pool);
+
+            std::atomic<unsigned long long int> visited(0);
+            std::atomic<unsigned long long int> wrong(0);
+            const gtl::layout_array_nd<unsigned long long int, layout_type, 0, 0, 0>& array_nd_const = array_nd;
+            gtl::parallel_for_each(array_nd_const, [&visited, &wrong](const unsigned long long int (&indexes)[3], const unsigned long long int& value) {
+                ++visited;
+                if (value != indexes[0] + indexes[1] * 1000 + indexes[2] * 1000000) {
+                    ++wrong;
+                }
+            }, thread_pool);
+
+            thread_pool.join();
+
+            REQUIRE(visited == 67 * 129 * 33);
+            REQUIRE(wrong == 0);
+        }
+    );
+}
+
+TEST(parallel_for_each, evaluation, transform) {
+    gtl::array_nd<int, 0, 0> source(300ull, 200ull);
+    gtl::parallel_for_each(source, [](const unsigned long long int (&indexes)[2], int& value) {
+        value = static_cast<int>(indexes[0] + indexes[1]);
+    });
+
+    gtl::layout_array_nd<long long int, gtl::array_layout_tiled<8>, 0, 0> destination(300ull, 200ull);
+    gtl::parallel_transform(destination, source, [](const unsigned long long int (&indexes)[2], const int& value) {
+        return static_cast<long long int>(value) * static_cast<long long int>(indexes[0]);
+    });
+
+    bool transformed = true;
+    for (unsigned long long int index2 = 0; index2 < 200; ++index2) {
+        for (unsigned long long int index1 = 0; index1 < 300; ++index1) {
+            transformed &= (destination(index1, index2) == static_cast<long long int>((index1 + index2) * index1));
+        }
+    }
+    REQUIRE(transformed);
+}
+
+TEST(parallel_for_each, evaluation, reduce) {
+    gtl::array_nd<float, 0, 0, 0> array_nd(100ull, 100ull, 100ull);
+    gtl::parallel_for_each(array_nd, [](const unsigned long long int (&indexes)[3], float& value) {
+        value = 1.0f / static_cast<float>(1 + indexes[0] + indexes[1] + indexes[2]);
+    });
+
+    const auto accumulate = [](float& partial, const unsigned long long int (&)[3], const float& value) {
+        partial += value;
+    };
+    const auto combine = [](const float& lhs, const float& rhs) {
+        return lhs + rhs;
+    };
+
+    // The partials are combined in block order, so the result is identical whatever the number of threads.
+    gtl::thread_pool thread_pool_none(0);
+    const float sum_none = gtl::parallel_reduce(array_nd, 0.0f, accumulate, combine, thread_pool_none);
+    thread_pool_none.join();
+
+    gtl::thread_pool thread_pool_many(4);
+    const float sum_many = gtl::parallel_reduce(array_nd, 0.0f, accumulate, combine, thread_pool_many);
+    thread_pool_many.join();
+
+    REQUIRE(sum_none == sum_many, "Expected identical sums, %.9g != %.9g", static_cast<double>(sum_none), static_cast<double>(sum_many));
+    REQUIRE(sum_none > 0.0f);
+
+    // Reductions can track the location of a value.
+    using maximum_type = std::pair<float, unsigned long long int>;
+    const maximum_type maximum = gtl::parallel_reduce(array_nd, maximum_type(0.0f, 0ull), [](maximum_type& partial, const unsigned long long int (&indexes)[3], const float& value) {
+        if (value > partial.first) {
+            partial = maximum_type(value, indexes[0] + indexes[1] * 100 + indexes[2] * 10000);
+        }
+    }, [](const maximum_type& lhs, const maximum_type& rhs) {
+        return (rhs.first > lhs.first) ? rhs : lhs;
+    });
+    REQUIRE(maximum.first == 1.0f);
+    REQUIRE(maximum.second == 0);
+}
+
+TEST(parallel_for_each, evaluation, reduce_bool) {
+    gtl::array_nd<float, 0, 0> array_nd(100ull, 100ull);
+    gtl::parallel_for_each(array_nd, [](const unsigned long long int (&indexes)[2], float& value) {
+        value = static_cast<float>(indexes[0] + indexes[1]);
+    });
+
+    // Each block must update its own partial, bools included.
+    const auto any_above = [&array_nd](float threshold) {
+        gtl::thread_pool thread_pool(4);
+        const bool result = gtl::parallel_reduce(array_nd, false, [threshold](bool& partial, const unsigned long long int (&)[2], const float& value) {
+            partial = partial || (value > threshold);
+        }, [](const bool& lhs, const bool& rhs) {
+            return lhs || rhs;
+        }, thread_pool);
+        thread_pool.join();
+        return result;
+    };
+    REQUIRE(any_above(197.0f) == true, "Expected the last element to be found.");
+    REQUIRE(any_above(198.0f) == false, "Expected no element to be found.");
+}
+
+TEST(parallel_for_each, evaluation, performance) {
+    gtl::array_nd<float, 0, 0, 0> array_nd(128ull, 128ull, 128ull);
+    gtl::thread_pool thread_pool;
+
+    const std::pair<double, unsigned long long int> serial_result = testbench::benchmark<void>([&](){
+        array_nd.for_each([](const unsigned long long int (&indexes)[3], float& value) {
+            value = static_cast<float>(indexes[0] * indexes[1] + indexes[2]);
+        });
+        testbench::do_not_optimise_away(array_nd);
+    }, 10, 0.1);
+    PRINT("Serial for_each:     %12.1f ns (%llu iterations)\n", serial_result.first, serial_result.second);
+
+    const std::pair<double, unsigned long long int> parallel_result = testbench::benchmark<void>([&](){
+        gtl::parallel_for_each(array_nd, [](const unsigned long long int (&indexes)[3], float& value) {
+            value = static_cast<float>(indexes[0] * indexes[1] + indexes[2]);
+        }, thread_pool);
+        testbench::do_not_optimise_away(array_nd);
+    }, 10, 0.1);
+    PRINT("Parallel for_each:   %12.1f ns (%llu iterations)\n", parallel_result.first, parallel_result.second);
+
+    thread_pool.join();
+
+    REQUIRE(array_nd(3ull, 5ull, 7ull) == static_cast<float>(3 * 5 + 7));
+}
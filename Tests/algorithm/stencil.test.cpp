@@ -0,0 +1,270 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <benchmark.tests.hpp>
+#include <comparison.tests.hpp>
+#include <print.tests.hpp>
+#include <require.tests.hpp>
+
+#include <algorithm/stencil>
+
+#include <container/array_nd>
+#include <container/static_array_nd>
+
+#if defined(_MSC_VER)
+#   pragma warning(push, 0)
+#endif
+
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+
+namespace {
+    using laplacian_2d = gtl::stencil<int, gtl::stencil_tap<0, 0>, gtl::stencil_tap<-1, 0>, gtl::stencil_tap<1, 0>, gtl::stencil_tap<0, -1>, gtl::stencil_tap<0, 1>>;
+
+    using laplacian_3d = gtl::stencil<float, gtl::stencil_tap<0, 0, 0>, gtl::stencil_tap<-1, 0, 0>, gtl::stencil_tap<1, 0, 0>, gtl::stencil_tap<0, -1, 0>, gtl::stencil_tap<0, 1, 0>, gtl::stencil_tap<0, 0, -1>, gtl::stencil_tap<0, 0, 1>>;
+
+    using weighted_laplacian_3d = gtl::stencil<float, gtl::stencil_weighted_tap<-6, 1, 0, 0, 0>, gtl::stencil_weighted_tap<1, 1, -1, 0, 0>, gtl::stencil_weighted_tap<1, 1, 1, 0, 0>, gtl::stencil_weighted_tap<1, 1, 0, -1, 0>, gtl::stencil_weighted_tap<1, 1, 0, 1, 0>, gtl::stencil_weighted_tap<1, 1, 0, 0, -1>, gtl::stencil_weighted_tap<1, 1, 0, 0, 1>>;
+
+    // Reference implementation that applies the border policy to every tap of every element.
+    template <typename stencil_type, typename array_type, typename index_function_type>
+    int reference(const stencil_type& stencil, const array_type& source, gtl::stencil_border border, long long int index1, long long int index2, const index_function_type& read) {
+        int result = 0;
+        for (unsigned long long int tap = 0; tap < stencil_type::tap_count; ++tap) {
+            long long int tap_index1 = index1 + stencil_type::offset(tap, 0);
+            long long int tap_index2 = index2 + stencil_type::offset(tap, 1);
+            const long long int size1 = static_cast<long long int>(source.size(0));
+            const long long int size2 = static_cast<long long int>(source.size(1));
+            if ((tap_index1 < 0) || (tap_index1 >= size1) || (tap_index2 < 0) || (tap_index2 >= size2)) {
+                if (border == gtl::stencil_border::zero) {
+                    continue;
+                }
+                if (border == gtl::stencil_border::clamp) {
+                    tap_index1 = (tap_index1 < 0) ? 0 : ((tap_index1 >= size1) ? size1 - 1 : tap_index1);
+                    tap_index2 = (tap_index2 < 0) ? 0 : ((tap_index2 >= size2) ? size2 - 1 : tap_index2);
+                }
+                else {
+                    tap_index1 = (tap_index1 + size1) % size1;
+                    tap_index2 = (tap_index2 + size2) % size2;
+                }
+            }
+            result += stencil.coefficient(tap) * read(static_cast<unsigned long long int>(tap_index1), static_cast<unsigned long long int>(tap_index2));
+        }
+        return result;
+    }
+}
+
+TEST(stencil, traits, standard) {
+    REQUIRE(laplacian_2d::tap_count == 5);
+    REQUIRE(laplacian_2d::dimension_count == 2);
+    REQUIRE(laplacian_2d::reach_before(0) == 1);
+    REQUIRE(laplacian_2d::reach_after(1) == 1);
+    REQUIRE((gtl::stencil<float, gtl::stencil_tap<0, 3>, gtl::stencil_tap<2, 1>>::reach_before(0) == 0));
+    REQUIRE((gtl::stencil<float, gtl::stencil_tap<0, 3>, gtl::stencil_tap<2, 1>>::reach_after(1) == 3));
+
+    // A convolution kernel is centred with the first dimension changing fastest.
+    using convolution_type = gtl::convolution_stencil<float, 5, 3>;
+    REQUIRE(convolution_type::tap_count == 15);
+    REQUIRE(convolution_type::dimension_count == 2);
+    REQUIRE(convolution_type::offset(0, 0) == -2);
+    REQUIRE(convolution_type::offset(0, 1) == -1);
+    REQUIRE(convolution_type::offset(1, 0) == -1);
+    REQUIRE(convolution_type::offset(7, 0) == 0);
+    REQUIRE(convolution_type::offset(7, 1) == 0);
+    REQUIRE(convolution_type::offset(14, 1) == 1);
+    REQUIRE(convolution_type::reach_before(0) == 2);
+    REQUIRE(convolution_type::reach_after(1) == 1);
+
+    constexpr laplacian_2d laplacian({ -4, 1, 1, 1, 1 });
+    REQUIRE(laplacian.coefficient(0) == -4);
+    REQUIRE(laplacian_2d::is_weighted == false);
+
+    // Weighted taps fix the weights at compile time.
+    REQUIRE(weighted_laplacian_3d::is_weighted == true);
+    REQUIRE(weighted_laplacian_3d::tap_count == 7);
+    constexpr weighted_laplacian_3d weighted_laplacian;
+    REQUIRE(weighted_laplacian.coefficient(0) == -6.0f);
+    REQUIRE(weighted_laplacian.coefficient(6) == 1.0f);
+    constexpr gtl::stencil<float, gtl::stencil_weighted_tap<1, 4, -1>, gtl::stencil_weighted_tap<1, 2, 0>, gtl::stencil_weighted_tap<1, 4, 1>> smooth;
+    REQUIRE(smooth.coefficient(0) == 0.25f);
+    REQUIRE(smooth.coefficient(1) == 0.5f);
+}
+
+TEST(stencil, function, weighted) {
+    constexpr static const unsigned long long int size = 19;
+    const laplacian_3d laplacian({ -6.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f });
+    const weighted_laplacian_3d weighted_laplacian;
+    gtl::array_nd<float, 0, 0, 0> source(size, size, size);
+    gtl::array_nd<float, 0, 0, 0> expected(size, size, size);
+    gtl::array_nd<float, 0, 0, 0> destination(size, size, size);
+    for (unsigned long long int index = 0; index < source.size(); ++index) {
+        source.data()[index] = static_cast<float>(index % 13);
+    }
+    for (gtl::stencil_border border : { gtl::stencil_border::clamp, gtl::stencil_border::wrap, gtl::stencil_border::zero }) {
+        laplacian.apply(expected, source, border);
+        weighted_laplacian.apply(destination, source, border);
+        bool matches = true;
+        for (unsigned long long int index = 0; index < source.size(); ++index) {
+            matches &= (destination.data()[index] == expected.data()[index]);
+        }
+        REQUIRE(matches, "Expected compile time weights to match the same weights set at run time for border %d.", static_cast<int>(border));
+    }
+}
+
+TEST(stencil, function, borders) {
+    const laplacian_2d laplacian({ -4, 1, 1, 1, 1 });
+    gtl::array_nd<int, 0, 0> source(13ull, 11ull);
+    for (unsigned long long int index2 = 0; index2 < 11; ++index2) {
+        for (unsigned long long int index1 = 0; index1 < 13; ++index1) {
+            source(index1, index2) = static_cast<int>((index1 * 7 + index2 * 13) % 17);
+        }
+    }
+    const auto read = [&source](unsigned long long int index1, unsigned long long int index2) {
+        return source(index1, index2);
+    };
+
+    for (gtl::stencil_border border : { gtl::stencil_border::clamp, gtl::stencil_border::wrap, gtl::stencil_border::zero }) {
+        gtl::array_nd<int, 0, 0> destination(13ull, 11ull);
+        laplacian.apply(destination, source, border);
+        bool matches = true;
+        for (long long int index2 = 0; index2 < 11; ++index2) {
+            for (long long int index1 = 0; index1 < 13; ++index1) {
+                matches &= (destination(index1, index2) == reference(laplacian, source, border, index1, index2, read));
+            }
+        }
+        REQUIRE(matches, "Expected border policy %d to match the reference.", static_cast<int>(border));
+    }
+
+    // A larger kernel on an array smaller than its reach only takes the border path.
+    const gtl::convolution_stencil<int, 5, 5> box({ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 });
+    gtl::array_nd<int, 3, 2> small_source;
+    gtl::array_nd<int, 3, 2> small_destination;
+    for (unsigned long long int index = 0; index < small_source.size(); ++index) {
+        small_source.data()[index] = 1;
+    }
+    box.apply(small_destination, small_source, gtl::stencil_border::zero);
+    REQUIRE(small_destination(0ull, 0ull) == 6);
+    box.apply(small_destination, small_source, gtl::stencil_border::clamp);
+    REQUIRE(small_destination(2ull, 1ull) == 25);
+}
+
+TEST(stencil, function, views) {
+    const laplacian_2d laplacian({ -4, 1, 1, 1, 1 });
+
+    // A static_array_nd has its last dimension contiguous.
+    gtl::static_array_nd<int, 9, 8> source;
+    for (unsigned long long int index1 = 0; index1 < 9; ++index1) {
+        for (unsigned long long int index2 = 0; index2 < 8; ++index2) {
+            source(index1, index2) = static_cast<int>(index1 * index1 + index2 * 3);
+        }
+    }
+    const auto read = [&source](unsigned long long int index1, unsigned long long int index2) {
+        return source(index1, index2);
+    };
+    gtl::static_array_nd<int, 9, 8> destination;
+    laplacian.apply(destination, source, gtl::stencil_border::wrap);
+    bool matches = true;
+    for (long long int index1 = 0; index1 < 9; ++index1) {
+        for (long long int index2 = 0; index2 < 8; ++index2) {
+            matches &= (destination(index1, index2) == reference(laplacian, source, gtl::stencil_border::wrap, index1, index2, read));
+        }
+    }
+    REQUIRE(matches);
+
+    // A transposed destination is written with strides.
+    gtl::array_nd<int, 8, 9> transposed;
+    gtl::array_view_nd<int, 2> transposed_view = gtl::array_view_nd<int, 2>(transposed).transpose();
+    laplacian.apply(transposed_view, source, gtl::stencil_border::wrap);
+    matches = true;
+    for (unsigned long long int index1 = 0; index1 < 9; ++index1) {
+        for (unsigned long long int index2 = 0; index2 < 8; ++index2) {
+            matches &= (transposed(index2, index1) == destination(index1, index2));
+        }
+    }
+    REQUIRE(matches);
+}
+
+TEST(stencil, function, parallel) {
+    const laplacian_3d laplacian({ -6.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f });
+    gtl::array_nd<float, 0, 0, 0> source(40ull, 30ull, 70ull);
+    for (unsigned long long int index = 0; index < source.size(); ++index) {
+        source.data()[index] = static_cast<float>((index * 2654435761ull) % 1000) / 100.0f;
+    }
+    gtl::array_nd<float, 0, 0, 0> serial(40ull, 30ull, 70ull);
+    laplacian.apply(serial, source, gtl::stencil_border::clamp);
+    REQUIRE(serial(5ull, 6ull, 7ull) == (-6.0f * source(5ull, 6ull, 7ull) + source(4ull, 6ull, 7ull) + source(6ull, 6ull, 7ull) + source(5ull, 5ull, 7ull) + source(5ull, 7ull, 7ull) + source(5ull, 6ull, 6ull) + source(5ull, 6ull, 8ull)));
+
+    for (unsigned int threads : { 0u, 4u }) {
+        gtl::thread_pool thread_pool(threads);
+        gtl::array_nd<float, 0, 0, 0> parallel(40ull, 30ull, 70ull);
+        laplacian.apply(parallel, source, gtl::stencil_border::clamp, thread_pool);
+        thread_pool.join();
+        bool matches = true;
+        for (unsigned long long int index = 0; index < source.size(); ++index) {
+            matches &= (parallel.data()[index] == serial.data()[index]);
+        }
+        REQUIRE(matches, "Expected %u threads to match the serial result.", threads);
+    }
+}
+
+TEST(stencil, evaluation, performance) {
+    constexpr static const unsigned long long int size = 96;
+    const laplacian_3d laplacian({ -6.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f });
+    gtl::array_nd<float, 0, 0, 0> source(size, size, size);
+    gtl::array_nd<float, 0, 0, 0> destination(size, size, size);
+    for (unsigned long long int index = 0; index < source.size(); ++index) {
+        source.data()[index] = static_cast<float>(index % 97);
+    }
+
+    const std::pair<double, unsigned long long int> stencil_result = testbench::benchmark<void>([&]() {
+        laplacian.apply(destination, source, gtl::stencil_border::clamp);
+        testbench::do_not_optimise_away(destination.data()[size]);
+    }, 10, 0.1);
+
+    // A hand written loop with the boundary handled inside the loop.
+    const std::pair<double, unsigned long long int> loop_result = testbench::benchmark<void>([&]() {
+        for (unsigned long long int index3 = 0; index3 < size; ++index3) {
+            for (unsigned long long int index2 = 0; index2 < size; ++index2) {
+                for (unsigned long long int index1 = 0; index1 < size; ++index1) {
+                    const unsigned long long int below1 = (index1 > 0) ? index1 - 1 : 0;
+                    const unsigned long long int above1 = (index1 < size - 1) ? index1 + 1 : size - 1;
+                    const unsigned long long int below2 = (index2 > 0) ? index2 - 1 : 0;
+                    const unsigned long long int above2 = (index2 < size - 1) ? index2 + 1 : size - 1;
+                    const unsigned long long int below3 = (index3 > 0) ? index3 - 1 : 0;
+                    const unsigned long long int above3 = (index3 < size - 1) ? index3 + 1 : size - 1;
+                    destination(index1, index2, index3) = -6.0f * source(index1, index2, index3) + source(below1, index2, index3) + source(above1, index2, index3) + source(index1, below2, index3) + source(index1, above2, index3) + source(index1, index2, below3) + source(index1, index2, above3);
+                }
+            }
+        }
+        testbench::do_not_optimise_away(destination.data()[size]);
+    }, 10, 0.1);
+
+    const weighted_laplacian_3d weighted_laplacian;
+    const std::pair<double, unsigned long long int> weighted_result = testbench::benchmark<void>([&]() {
+        weighted_laplacian.apply(destination, source, gtl::stencil_border::clamp);
+        testbench::do_not_optimise_away(destination.data()[size]);
+    }, 10, 0.1);
+
+    PRINT("Stencil: %.0fns, compile time weights: %.0fns, hand written loop: %.0fns.\n", stencil_result.first, weighted_result.first, loop_result.first);
+}
@@ -0,0 +1,91 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <benchmark.tests.hpp>
+#include <require.tests.hpp>
+
+#include <container/aligned_allocator>
+
+#if defined(_MSC_VER)
+#   pragma warning(push, 0)
+#endif
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+
+TEST(aligned_allocator, traits, standard) {
+    REQUIRE(sizeof(gtl::aligned_allocator<float>) == 1, "sizeof(gtl::aligned_allocator<float>) = %ld, expected == %lld", sizeof(gtl::aligned_allocator<float>), 1ull);
+
+    REQUIRE(std::is_empty<gtl::aligned_allocator<float>>::value == true, "Expected std::is_empty to be true.");
+
+    REQUIRE(std::is_trivially_copyable<gtl::aligned_allocator<float>>::value == true, "Expected std::is_trivially_copyable to be true.");
+
+    REQUIRE((std::is_same<typename std::allocator_traits<gtl::aligned_allocator<float, 4096>>::rebind_alloc<double>, gtl::aligned_allocator<double, 4096>>::value), "Expected rebinding to keep the alignment.");
+}
+
+TEST(aligned_allocator, function, allocate) {
+    gtl::aligned_allocator<char, 64> cache_line_allocator;
+    gtl::aligned_allocator<char, 4096> page_allocator;
+    for (unsigned long long int count = 1; count < 100000; count = count * 3 + 1) {
+        char* cache_line_pointer = cache_line_allocator.allocate(count);
+        REQUIRE((reinterpret_cast<unsigned long long int>(cache_line_pointer) % 64) == 0, "Allocation of %llu bytes is not 64 byte aligned.", count);
+        cache_line_pointer[0] = 1;
+        cache_line_pointer[count - 1] = 1;
+        cache_line_allocator.deallocate(cache_line_pointer, count);
+
+        char* page_pointer = page_allocator.allocate(count);
+        REQUIRE((reinterpret_cast<unsigned long long int>(page_pointer) % 4096) == 0, "Allocation of %llu bytes is not page aligned.", count);
+        page_allocator.deallocate(page_pointer, count);
+    }
+}
+
+TEST(aligned_allocator, function, huge_pages) {
+    using allocator_type = gtl::aligned_allocator<float, 64, true>;
+    allocator_type allocator;
+
+    // Small allocations keep the requested alignment.
+    float* small = allocator.allocate(16);
+    REQUIRE((reinterpret_cast<unsigned long long int>(small) % 64) == 0, "Small allocation is not 64 byte aligned.");
+    allocator.deallocate(small, 16);
+
+    // Allocations of at least a huge page are aligned to one.
+    const unsigned long long int count = (3 * allocator_type::huge_page_size) / sizeof(float) + 1;
+    float* large = allocator.allocate(count);
+    REQUIRE((reinterpret_cast<unsigned long long int>(large) % allocator_type::huge_page_size) == 0, "Large allocation is not huge page aligned.");
+    for (unsigned long long int index = 0; index < count; index += 1024) {
+        large[index] = static_cast<float>(index);
+    }
+    allocator.deallocate(large, count);
+}
+
+TEST(aligned_allocator, evaluation, standard_container) {
+    std::vector<double, gtl::aligned_allocator<double, 128>> vector;
+    for (unsigned int index = 0; index < 1000; ++index) {
+        vector.push_back(index);
+        REQUIRE((reinterpret_cast<unsigned long long int>(vector.data()) % 128) == 0, "Vector data is not 128 byte aligned.");
+    }
+    REQUIRE(vector[999] == 999.0);
+}
@@ -0,0 +1,254 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <benchmark.tests.hpp>
+#include <require.tests.hpp>
+#include <print.tests.hpp>
+
+#include <container/array_expression>
+
+#if defined(_MSC_VER)
+#   pragma warning(push, 0)
+#endif
+
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+
+namespace {
+    // An odd size so every kernel also has elements left over that do not fill a vector.
+    constexpr static const unsigned long long int test_size = 1027;
+
+    template <typename function_type>
+    void for_each_supported_instructions(function_type&& function) {
+        for (unsigned int instructions = 0; instructions <= static_cast<unsigned int>(gtl::array_expression::get_instructions()); ++instructions) {
+            function(static_cast<gtl::array_expression_instructions>(instructions));
+        }
+    }
+}
+
+TEST(array_expression, traits, standard) {
+    REQUIRE(sizeof(gtl::array_expression_operand<float>) == sizeof(const float*) + sizeof(gtl::array_expression_shape), "sizeof(gtl::array_expression_operand<float>) = %ld", sizeof(gtl::array_expression_operand<float>));
+
+    REQUIRE(sizeof(gtl::array_expression_scalar<double>) == sizeof(double), "sizeof(gtl::array_expression_scalar<double>) = %ld, expected == %lld", sizeof(gtl::array_expression_scalar<double>), static_cast<unsigned long long int>(sizeof(double)));
+
+    using expression_type = decltype(gtl::array_nd<float, 0>() + gtl::array_nd<float, 0>() * 2.0f);
+
+    REQUIRE(std::is_trivially_copyable<expression_type>::value == true, "Expected std::is_trivially_copyable to be true.");
+
+    REQUIRE((std::is_same<typename expression_type::type, float>::value), "Expected the expression to compute floats.");
+
+    REQUIRE((std::is_same<typename decltype(gtl::array_nd<float, 0>() < 1.0f)::type, bool>::value), "Expected a comparison to produce bools.");
+
+    REQUIRE((gtl::array_expression::is_buildable<gtl::array_nd<int, 0>, int>::value == true), "Expected an array and a scalar to build an expression.");
+
+    REQUIRE((gtl::array_expression::is_buildable<int, int>::value == false), "Expected two scalars not to build an expression.");
+}
+
+TEST(array_expression, function, get_instructions) {
+    const gtl::array_expression_instructions instructions = gtl::array_expression::get_instructions();
+    REQUIRE(instructions == gtl::array_expression::get_instructions(), "Expected the instruction set to be cached.");
+    #if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        REQUIRE(instructions >= gtl::array_expression_instructions::sse2, "Expected at least sse2 on x86.");
+    #endif
+    PRINT("Array expression instruction set: %u\n", static_cast<unsigned int>(instructions));
+}
+
+TEST(array_expression, evaluation, arithmetic) {
+    auto test = [](auto value) {
+        using type = decltype(value);
+        gtl::array_nd<type, 0> a(test_size);
+        gtl::array_nd<type, 0> b(test_size);
+        gtl::array_nd<type, 0> c(test_size);
+        for (unsigned long long int index = 0; index < test_size; ++index) {
+            a(index) = static_cast<type>(index);
+            b(index) = static_cast<type>(index % 7) - 3;
+            c(index) = static_cast<type>(1 << (index % 4));
+        }
+        for_each_supported_instructions([&](gtl::array_expression_instructions instructions) {
+            gtl::array_nd<type, 0> result(test_size);
+            gtl::evaluate(result, -a + b * c - a / c + 2, instructions);
+            for (unsigned long long int index = 0; index < test_size; ++index) {
+                const type expected = -a(index) + b(index) * c(index) - a(index) / c(index) + 2;
+                REQUIRE(result(index) == expected, "Instructions %u, index %llu: %f != %f", static_cast<unsigned int>(instructions), index, static_cast<double>(result(index)), static_cast<double>(expected));
+            }
+        });
+    };
+    test(float());
+    test(double());
+    test(int());
+}
+
+TEST(array_expression, evaluation, functions) {
+    auto test = [](auto value) {
+        using type = decltype(value);
+        gtl::array_nd<type, 0> a(test_size);
+        gtl::array_nd<type, 0> b(test_size);
+        for (unsigned long long int index = 0; index < test_size; ++index) {
+            a(index) = static_cast<type>(index * index);
+            b(index) = static_cast<type>((index * 37) % 1000);
+        }
+        for_each_supported_instructions([&](gtl::array_expression_instructions instructions) {
+            gtl::array_nd<type, 0> result(test_size);
+            gtl::evaluate(result, sqrt(a) + min(a, b) * 2 - max(b, 500), instructions);
+            for (unsigned long long int index = 0; index < test_size; ++index) {
+                const type expected = std::sqrt(a(index)) + ((a(index) < b(index)) ? a(index) : b(index)) * 2 - ((b(index) > 500) ? b(index) : 500);
+                REQUIRE(result(index) == expected, "Instructions %u, index %llu: %f != %f", static_cast<unsigned int>(instructions), index, static_cast<double>(result(index)), static_cast<double>(expected));
+            }
+        });
+    };
+    test(float());
+    test(double());
+}
+
+TEST(array_expression, evaluation, comparisons) {
+    gtl::array_nd<double, 0> a(test_size);
+    gtl::array_nd<double, 0> b(test_size);
+    for (unsigned long long int index = 0; index < test_size; ++index) {
+        a(index) = static_cast<double>(index % 13);
+        b(index) = static_cast<double>(index % 5);
+    }
+
+    gtl::array_nd<bool, 0> mask(test_size);
+    gtl::evaluate(mask, a <= b);
+    for (unsigned long long int index = 0; index < test_size; ++index) {
+        REQUIRE(mask(index) == (a(index) <= b(index)), "Index %llu has the wrong comparison result.", index);
+    }
+
+    for_each_supported_instructions([&](gtl::array_expression_instructions instructions) {
+        gtl::array_nd<double, 0> result(test_size);
+        gtl::evaluate(result, select(a < b, a, b * 10) + select(a == b, 1, 0) + select(a != 4, 0, 100) + select(a >= b, 1000, 0) + select(a > 8, 10000, 0), instructions);
+        for (unsigned long long int index = 0; index < test_size; ++index) {
+            const double expected = ((a(index) < b(index)) ? a(index) : b(index) * 10) + (a(index) == b(index)) + (a(index) != 4 ? 0 : 100) + (a(index) >= b(index) ? 1000 : 0) + (a(index) > 8 ? 10000 : 0);
+            REQUIRE(result(index) == expected, "Instructions %u, index %llu: %f != %f", static_cast<unsigned int>(instructions), index, result(index), expected);
+        }
+    });
+}
+
+TEST(array_expression, evaluation, static_array_nd) {
+    gtl::static_array_nd<float, 5, 7> a = {};
+    gtl::static_array_nd<float, 5, 7> b = {};
+    for (unsigned long long int x = 0; x < 5; ++x) {
+        for (unsigned long long int y = 0; y < 7; ++y) {
+            a(x, y) = static_cast<float>(x * 7 + y);
+            b(x, y) = static_cast<float>(y);
+        }
+    }
+
+    gtl::static_array_nd<float, 5, 7> result = {};
+    gtl::evaluate(result, a * 2 - b);
+    for (unsigned long long int x = 0; x < 5; ++x) {
+        for (unsigned long long int y = 0; y < 7; ++y) {
+            REQUIRE(result(x, y) == a(x, y) * 2 - b(x, y), "Element %llu, %llu is wrong.", x, y);
+        }
+    }
+
+    // One dimensional arrays have the same layout whichever class stores them.
+    gtl::static_array_nd<float, 35> c = {};
+    gtl::array_nd<float, 35> d;
+    for (unsigned long long int index = 0; index < 35; ++index) {
+        c(index) = static_cast<float>(index);
+        d(index) = static_cast<float>(index * 3);
+    }
+    gtl::evaluate(d, c + d);
+    for (unsigned long long int index = 0; index < 35; ++index) {
+        REQUIRE(d(index) == static_cast<float>(index * 4), "Element %llu is wrong.", index);
+    }
+
+    REQUIRE((decltype(a + b)::layout == gtl::array_expression_layout::row_major), "Expected a static_array_nd expression to be row major.");
+    REQUIRE((decltype(gtl::array_nd<float, 5, 7>() + 1.0f)::layout == gtl::array_expression_layout::column_major), "Expected an array_nd expression to be column major.");
+    REQUIRE((decltype(c + d)::layout == gtl::array_expression_layout::any), "Expected a one dimensional expression to have any layout.");
+
+    // A row-major array_nd stores its elements in the same order as a static_array_nd.
+    gtl::layout_array_nd<float, gtl::array_layout_row_major, 5, 7> e;
+    gtl::evaluate(e, a + b);
+    for (unsigned long long int x = 0; x < 5; ++x) {
+        for (unsigned long long int y = 0; y < 7; ++y) {
+            REQUIRE(e(x, y) == a(x, y) + b(x, y), "Element %llu, %llu is wrong.", x, y);
+        }
+    }
+
+    REQUIRE((gtl::array_expression::is_buildable<gtl::layout_array_nd<float, gtl::array_layout_tiled<8>, 0, 0>, float>::value == false), "Expected a padded layout not to build an expression.");
+}
+
+TEST(array_expression, function, has_shape) {
+    gtl::array_nd<float, 2, 3> a;
+    gtl::array_nd<float, 3, 2> b;
+    gtl::array_nd<float, 2, 3> c;
+    gtl::layout_array_nd<float, gtl::array_layout_row_major, 2, 3> d;
+    gtl::array_nd<float, 6> e;
+
+    REQUIRE((a + c).has_shape(gtl::array_expression_traits<gtl::array_nd<float, 2, 3>>::shape(c)), "Expected arrays with the same dimension sizes to match.");
+    REQUIRE(!(a + b).has_shape(gtl::array_expression_traits<gtl::array_nd<float, 2, 3>>::shape(c)), "Expected 2x3 and 3x2 arrays not to match.");
+    REQUIRE(!(a * 2.0f).has_shape(gtl::array_expression_traits<gtl::array_nd<float, 3, 2>>::shape(b)), "Expected a 2x3 array not to evaluate into a 3x2 array.");
+    REQUIRE((e + 1.0f).has_shape(gtl::array_expression_traits<gtl::array_nd<float, 2, 3>>::shape(c)), "Expected a one dimensional array to match by the number of elements.");
+
+    gtl::static_array_nd<float, 3, 2> f;
+    gtl::static_array_nd<float, 2, 3> g;
+    REQUIRE((f + 1.0f).has_shape(gtl::array_expression_traits<gtl::layout_array_nd<float, gtl::array_layout_row_major, 2, 3>>::shape(d)) == false, "Expected a 3x2 static array not to match a 2x3 array.");
+    REQUIRE((g + 1.0f).has_shape(gtl::array_expression_traits<gtl::layout_array_nd<float, gtl::array_layout_row_major, 2, 3>>::shape(d)), "Expected a 2x3 static array to match a 2x3 row major array.");
+}
+
+TEST(array_expression, evaluation, in_place) {
+    gtl::array_nd<float, 0> a(test_size);
+    gtl::evaluate(a, 3.0f);
+    for (unsigned long long int index = 0; index < test_size; ++index) {
+        REQUIRE(a(index) == 3.0f, "Index %llu was not filled.", index);
+    }
+
+    gtl::evaluate(a, a * a + 1);
+    for (unsigned long long int index = 0; index < test_size; ++index) {
+        REQUIRE(a(index) == 10.0f, "Index %llu was not updated in place.", index);
+    }
+
+    gtl::array_nd<float, 0> b(test_size);
+    gtl::evaluate(b, a);
+    for (unsigned long long int index = 0; index < test_size; ++index) {
+        REQUIRE(b(index) == 10.0f, "Index %llu was not copied.", index);
+    }
+}
+
+TEST(array_expression, evaluation, fused_against_scalar) {
+    constexpr static const unsigned long long int size = 1 << 16;
+    gtl::array_nd<float, size> a;
+    gtl::array_nd<float, size> b;
+    gtl::array_nd<float, size> result;
+    for (unsigned long long int index = 0; index < size; ++index) {
+        a(index) = static_cast<float>(index % 100);
+        b(index) = static_cast<float>(index % 77);
+    }
+
+    const std::pair<double, unsigned long long int> scalar_result = testbench::benchmark<void>([&](){
+        gtl::evaluate(result, sqrt(a * a + b * b) * 0.5f + min(a, b), gtl::array_expression_instructions::scalar);
+        testbench::do_not_optimise_away(result);
+    }, 10, 0.1);
+    PRINT("Scalar kernel:     %12.1f ns (%llu iterations)\n", scalar_result.first, scalar_result.second);
+
+    const std::pair<double, unsigned long long int> vector_result = testbench::benchmark<void>([&](){
+        gtl::evaluate(result, sqrt(a * a + b * b) * 0.5f + min(a, b));
+        testbench::do_not_optimise_away(result);
+    }, 10, 0.1);
+    PRINT("Best kernel:       %12.1f ns (%llu iterations)\n", vector_result.first, vector_result.second);
+}
@@ -0,0 +1,126 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <benchmark.tests.hpp>
+#include <comparison.tests.hpp>
+#include <data.tests.hpp>
+#include <require.tests.hpp>
+#include <template.tests.hpp>
+
+#include <container/array_layout>
+
+#if defined(_MSC_VER)
+#   pragma warning(push, 0)
+#endif
+
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+
+namespace {
+    template <typename layout_type>
+    bool is_bijective(const unsigned long long int (&sizes)[2]) {
+        const typename layout_type::template mapping<2> mapping(sizes);
+        std::vector<bool> used(mapping.size, false);
+        for (unsigned long long int index1 = 0; index1 < sizes[1]; ++index1) {
+            for (unsigned long long int index0 = 0; index0 < sizes[0]; ++index0) {
+                const unsigned long long int offset = mapping.template offset<0>(index0) + mapping.template offset<1>(index1);
+                if ((offset >= mapping.size) || used[offset]) {
+                    return false;
+                }
+                used[offset] = true;
+            }
+        }
+        return true;
+    }
+}
+
+TEST(array_layout, traits, standard) {
+    REQUIRE(gtl::array_layout_column_major::is_linear == true);
+    REQUIRE(gtl::array_layout_row_major::is_linear == true);
+    REQUIRE(gtl::array_layout_tiled<>::is_linear == false);
+    REQUIRE(gtl::array_layout_morton::is_linear == false);
+
+    REQUIRE(std::is_trivially_copyable<gtl::array_layout_column_major::mapping<3>>::value == true, "Expected std::is_trivially_copyable to be true.");
+    REQUIRE(std::is_trivially_copyable<gtl::array_layout_tiled<8>::mapping<3>>::value == true, "Expected std::is_trivially_copyable to be true.");
+    REQUIRE(std::is_trivially_copyable<gtl::array_layout_morton::mapping<3>>::value == true, "Expected std::is_trivially_copyable to be true.");
+}
+
+TEST(array_layout, function, column_major) {
+    constexpr static const unsigned long long int sizes[3] = { 2, 3, 4 };
+    constexpr static const gtl::array_layout_column_major::mapping<3> mapping(sizes);
+    static_assert(mapping.size == 24, "Column-major storage is not padded.");
+    REQUIRE(mapping.step(0) == 1);
+    REQUIRE(mapping.step(1) == 2);
+    REQUIRE(mapping.step(2) == 6);
+    REQUIRE(mapping.offset<0>(1) + mapping.offset<1>(2) + mapping.offset<2>(3) == 1 + 2 * 2 + 3 * 6);
+}
+
+TEST(array_layout, function, row_major) {
+    constexpr static const unsigned long long int sizes[3] = { 2, 3, 4 };
+    constexpr static const gtl::array_layout_row_major::mapping<3> mapping(sizes);
+    static_assert(mapping.size == 24, "Row-major storage is not padded.");
+    REQUIRE(mapping.step(0) == 12);
+    REQUIRE(mapping.step(1) == 4);
+    REQUIRE(mapping.step(2) == 1);
+    REQUIRE(mapping.offset<0>(1) + mapping.offset<1>(2) + mapping.offset<2>(3) == 1 * 12 + 2 * 4 + 3);
+}
+
+TEST(array_layout, function, tiled) {
+    constexpr static const unsigned long long int sizes[2] = { 10, 3 };
+    constexpr static const gtl::array_layout_tiled<4>::mapping<2> mapping(sizes);
+    static_assert(mapping.size == 12 * 4, "Tiled storage pads each dimension to whole tiles.");
+
+    // The first tile holds the 4x4 block at the origin in column-major order.
+    REQUIRE(mapping.offset<0>(3) + mapping.offset<1>(0) == 3);
+    REQUIRE(mapping.offset<0>(0) + mapping.offset<1>(1) == 4);
+    REQUIRE(mapping.offset<0>(3) + mapping.offset<1>(2) == 11);
+
+    // The second tile starts after the first in the first dimension.
+    REQUIRE(mapping.offset<0>(4) + mapping.offset<1>(0) == 16);
+
+    REQUIRE(is_bijective<gtl::array_layout_tiled<4>>({ 10, 3 }));
+    REQUIRE(is_bijective<gtl::array_layout_tiled<8>>({ 17, 33 }));
+}
+
+TEST(array_layout, function, morton) {
+    constexpr static const unsigned long long int sizes[2] = { 4, 4 };
+    constexpr static const gtl::array_layout_morton::mapping<2> mapping(sizes);
+    static_assert(mapping.size == 16, "Power of two Morton storage is not padded.");
+
+    // The Z-order curve interleaves the bits of the indexes, the first dimension in the lowest bit.
+    REQUIRE(mapping.offset<0>(1) + mapping.offset<1>(0) == 1);
+    REQUIRE(mapping.offset<0>(0) + mapping.offset<1>(1) == 2);
+    REQUIRE(mapping.offset<0>(1) + mapping.offset<1>(1) == 3);
+    REQUIRE(mapping.offset<0>(2) + mapping.offset<1>(0) == 4);
+    REQUIRE(mapping.offset<0>(3) + mapping.offset<1>(3) == 15);
+
+    // Rectangular arrays pad each dimension separately.
+    constexpr static const unsigned long long int rectangle_sizes[2] = { 100, 3 };
+    constexpr static const gtl::array_layout_morton::mapping<2> rectangle_mapping(rectangle_sizes);
+    REQUIRE(rectangle_mapping.size == 128 * 4);
+
+    REQUIRE(is_bijective<gtl::array_layout_morton>({ 100, 3 }));
+    REQUIRE(is_bijective<gtl::array_layout_morton>({ 5, 70 }));
+}
@@ -22,6 +22,7 @@ THE SOFTWARE
 #include <benchmark.tests.hpp>
 #include <comparison.tests.hpp>
 #include <data.tests.hpp>
+#include <print.tests.hpp>
 #include <require.tests.hpp>
 #include <template.tests.hpp>
 
@@ -31,7 +32,9 @@ THE SOFTWARE
 #   pragma warning(push, 0)
 #endif
 
+#include <memory>
 #include <type_traits>
+#include <utility>
 
 #if defined(_MSC_VER)
 #   pragma warning(pop)
@@ -399,3 +402,275 @@ TEST(array_nd, operator, parenthesis) {
         }
     );
 }
+
+namespace {
+    // An allocator that counts its allocations and constructions to check array_nd uses it correctly.
+    struct counters {
+        unsigned long long int allocations = 0;
+        unsigned long long int deallocations = 0;
+    };
+
+    template <typename type>
+    struct counting_allocator {
+        using value_type = type;
+
+        counters* count;
+
+        explicit counting_allocator(counters* allocator_count)
+            : count(allocator_count) {
+        }
+
+        template <typename other_type>
+        counting_allocator(const counting_allocator<other_type>& other)
+            : count(other.count) {
+        }
+
+        type* allocate(unsigned long long int size) {
+            ++this->count->allocations;
+            return std::allocator<type>().allocate(size);
+        }
+
+        void deallocate(type* pointer, unsigned long long int size) {
+            ++this->count->deallocations;
+            std::allocator<type>().deallocate(pointer, size);
+        }
+
+        bool operator==(const counting_allocator& other) const {
+            return this->count == other.count;
+        }
+
+        bool operator!=(const counting_allocator& other) const {
+            return this->count != other.count;
+        }
+    };
+
+    struct lifetime {
+        static inline long long int alive = 0;
+        int value = 7;
+        lifetime() {
+            ++lifetime::alive;
+        }
+        lifetime(const lifetime& other)
+            : value(other.value) {
+            ++lifetime::alive;
+        }
+        ~lifetime() {
+            --lifetime::alive;
+        }
+    };
+}
+
+TEST(array_nd, constructor, aligned) {
+    gtl::array_nd<char, 0> array_nd_1d(3ull);
+    REQUIRE((reinterpret_cast<unsigned long long int>(array_nd_1d.data()) % 64) == 0, "Expected dynamic data to be 64 byte aligned.");
+
+    gtl::basic_array_nd<float, gtl::aligned_allocator<float, 4096>, gtl::array_layout_column_major, 0, 0> array_nd_2d(5ull, 7ull);
+    REQUIRE((reinterpret_cast<unsigned long long int>(array_nd_2d.data()) % 4096) == 0, "Expected dynamic data to be page aligned.");
+
+    gtl::basic_array_nd<float, gtl::aligned_allocator<float, 64, true>, gtl::array_layout_column_major, 0, 0> array_nd_huge(1024ull, 1024ull);
+    REQUIRE((reinterpret_cast<unsigned long long int>(array_nd_huge.data()) % (2 * 1024 * 1024)) == 0, "Expected a huge page array to be huge page aligned.");
+    array_nd_huge(1023ull, 1023ull) = 1.0f;
+}
+
+TEST(array_nd, constructor, allocator) {
+    counters count;
+    {
+        using array_type = gtl::basic_array_nd<int, counting_allocator<int>, gtl::array_layout_column_major, 0, 4>;
+        array_type array_nd_2d(counting_allocator<int>(&count), 3ull);
+        REQUIRE(count.allocations == 1, "Expected the array to allocate once.");
+        REQUIRE(array_nd_2d.get_allocator() == counting_allocator<int>(&count), "Expected the array to keep its allocator.");
+        REQUIRE(array_nd_2d.size() == 12);
+
+        array_type copy(array_nd_2d);
+        REQUIRE(count.allocations == 2, "Expected the copy to allocate with the copied allocator.");
+
+        array_type moved(std::move(copy));
+        REQUIRE(count.allocations == 2, "Expected a move not to allocate.");
+        REQUIRE(moved.size() == 12);
+
+        array_type empty(counting_allocator<int>(&count), 1ull);
+        empty = moved;
+        REQUIRE(count.allocations == 4, "Expected assignment to copy then allocate.");
+    }
+    REQUIRE(count.allocations == count.deallocations, "Expected every allocation to be freed, %llu != %llu.", count.allocations, count.deallocations);
+}
+
+TEST(array_nd, constructor, uninitialised) {
+    using array_type = gtl::array_nd<float, 0, 0>;
+    array_type array_nd_2d(array_type::uninitialised(), 100ull, 100ull);
+    REQUIRE(array_nd_2d.size() == 10000);
+    for (unsigned long long int index = 0; index < array_nd_2d.size(); ++index) {
+        array_nd_2d.data()[index] = static_cast<float>(index);
+    }
+    REQUIRE(array_nd_2d(99ull, 99ull) == 9999.0f);
+}
+
+TEST(array_nd, evaluation, lifetime) {
+    {
+        gtl::array_nd<lifetime, 0, 0> array_nd_2d(4ull, 5ull);
+        REQUIRE(lifetime::alive == 20, "Expected every element to be constructed, %lld alive.", lifetime::alive);
+        REQUIRE(array_nd_2d(3ull, 4ull).value == 7);
+
+        gtl::array_nd<lifetime, 0, 0> copy(array_nd_2d);
+        REQUIRE(lifetime::alive == 40, "Expected every element to be copied, %lld alive.", lifetime::alive);
+
+        gtl::array_nd<lifetime, 0, 0> moved(std::move(copy));
+        REQUIRE(lifetime::alive == 40, "Expected a move not to construct, %lld alive.", lifetime::alive);
+    }
+    REQUIRE(lifetime::alive == 0, "Expected every element to be destroyed, %lld alive.", lifetime::alive);
+}
+
+TEST(array_nd, function, step) {
+    gtl::array_nd<float, 2, 3, 4> array_nd_static;
+    REQUIRE(array_nd_static.step(0) == 1);
+    REQUIRE(array_nd_static.step(1) == 2);
+    REQUIRE(array_nd_static.step(2) == 6);
+
+    gtl::array_nd<float, 0, 3, 0> array_nd_mixed(2ull, 4ull);
+    REQUIRE(array_nd_mixed.step(0) == 1);
+    REQUIRE(array_nd_mixed.step(1) == 2);
+    REQUIRE(array_nd_mixed.step(2) == 6);
+
+    gtl::array_nd<float, 0, 3, 0> array_nd_copy(array_nd_mixed);
+    REQUIRE(array_nd_copy.step(2) == 6);
+
+    gtl::array_nd<float, 0, 3, 0> array_nd_moved(5ull, 7ull);
+    array_nd_moved = std::move(array_nd_copy);
+    REQUIRE(array_nd_moved.step(1) == 2);
+    REQUIRE(array_nd_moved.step(2) == 6);
+    REQUIRE(array_nd_moved.data(1, 2, 3) == array_nd_moved.data() + 1 + 2 * 2 + 3 * 6);
+}
+
+TEST(array_nd, evaluation, indexing) {
+    constexpr static const unsigned long long int size = 64;
+    gtl::array_nd<float, 0, 0, 0> array_nd_dynamic(size, size, size);
+    gtl::array_nd<float, 0, 0, 0> array_nd_raw(size, size, size);
+    for (unsigned long long int index = 0; index < array_nd_dynamic.size(); ++index) {
+        array_nd_dynamic.data()[index] = static_cast<float>(index % 7);
+        array_nd_raw.data()[index] = static_cast<float>(index % 7);
+    }
+
+    float array_nd_sum = 0.0f;
+    const std::pair<double, unsigned long long int> array_nd_result = testbench::benchmark<void>([&](){
+        float sum = 0.0f;
+        for (unsigned long long int index3 = 0; index3 < size; ++index3) {
+            for (unsigned long long int index2 = 0; index2 < size; ++index2) {
+                for (unsigned long long int index1 = 0; index1 < size; ++index1) {
+                    sum += array_nd_dynamic(index1, index2, index3);
+                }
+            }
+        }
+        array_nd_sum = sum;
+        testbench::do_not_optimise_away(array_nd_sum);
+    }, 10, 0.1);
+    PRINT("array_nd indexing:      %12.1f ns (%llu iterations)\n", array_nd_result.first, array_nd_result.second);
+
+    float raw_sum = 0.0f;
+    const std::pair<double, unsigned long long int> raw_result = testbench::benchmark<void>([&](){
+        const float* pointer = array_nd_raw.data();
+        const unsigned long long int step2 = size;
+        const unsigned long long int step3 = size * size;
+        float sum = 0.0f;
+        for (unsigned long long int index3 = 0; index3 < size; ++index3) {
+            for (unsigned long long int index2 = 0; index2 < size; ++index2) {
+                for (unsigned long long int index1 = 0; index1 < size; ++index1) {
+                    sum += pointer[index1 + index2 * step2 + index3 * step3];
+                }
+            }
+        }
+        raw_sum = sum;
+        testbench::do_not_optimise_away(raw_sum);
+    }, 10, 0.1);
+    PRINT("Raw pointer indexing:   %12.1f ns (%llu iterations)\n", raw_result.first, raw_result.second);
+
+    REQUIRE(testbench::is_value_equal(array_nd_sum, raw_sum));
+
+    // The cached steps must give exactly the raw pointer offsets.
+    bool offsets_match = true;
+    for (unsigned long long int index3 = 0; index3 < size; ++index3) {
+        for (unsigned long long int index2 = 0; index2 < size; ++index2) {
+            for (unsigned long long int index1 = 0; index1 < size; ++index1) {
+                offsets_match &= (&array_nd_dynamic(index1, index2, index3) == array_nd_dynamic.data() + index1 + index2 * size + index3 * size * size);
+            }
+        }
+    }
+    REQUIRE(offsets_match == true, "Expected array_nd indexing to match raw pointer offsets.");
+}
+
+TEST(array_nd, function, layout) {
+    testbench::test_template<testbench::type_collection<gtl::array_layout_column_major, gtl::array_layout_row_major, gtl::array_layout_tiled<4>, gtl::array_layout_morton>>(
+        [](auto test_layout)->void {
+            using layout_type = typename decltype(test_layout)::type;
+
+            gtl::layout_array_nd<unsigned long long int, layout_type, 0, 0, 0> array_nd_dynamic(5ull, 6ull, 7ull);
+            gtl::layout_array_nd<unsigned long long int, layout_type, 5, 6, 7> array_nd_static;
+            REQUIRE(array_nd_dynamic.size() == 5 * 6 * 7);
+            REQUIRE(array_nd_dynamic.storage_size() >= array_nd_dynamic.size());
+            REQUIRE(array_nd_static.storage_size() == array_nd_dynamic.storage_size());
+
+            for (unsigned long long int index3 = 0; index3 < 7; ++index3) {
+                for (unsigned long long int index2 = 0; index2 < 6; ++index2) {
+                    for (unsigned long long int index1 = 0; index1 < 5; ++index1) {
+                        array_nd_dynamic(index1, index2, index3) = index1 + index2 * 100 + index3 * 10000;
+                        array_nd_static(index1, index2, index3) = index1 + index2 * 100 + index3 * 10000;
+                    }
+                }
+            }
+
+            // Every element is visited once with its own location, whatever the layout.
+            unsigned long long int visited = 0;
+            unsigned long long int visited_sum = 0;
+            bool visited_correct = true;
+            array_nd_dynamic.for_each([&](const unsigned long long int (&indexes)[3], unsigned long long int& value) {
+                ++visited;
+                visited_sum += value;
+                visited_correct &= (value == indexes[0] + indexes[1] * 100 + indexes[2] * 10000);
+                visited_correct &= (value == array_nd_static(indexes));
+            });
+            REQUIRE(visited == array_nd_dynamic.size());
+            REQUIRE(visited_correct);
+            REQUIRE(visited_sum == (0 + 1 + 2 + 3 + 4) * 6 * 7 + (0 + 100 + 200 + 300 + 400 + 500) * 5 * 7 + (0 + 1 + 2 + 3 + 4 + 5 + 6) * 10000 * 5 * 6);
+
+            // A region is visited in part.
+            visited = 0;
+            array_nd_dynamic.for_each({ 1, 2, 3 }, { 4, 6, 4 }, [&](const unsigned long long int (&indexes)[3], const unsigned long long int& value) {
+                ++visited;
+                visited_correct &= (indexes[0] >= 1) && (indexes[0] < 4) && (indexes[1] >= 2) && (indexes[1] < 6) && (indexes[2] == 3);
+                visited_correct &= (value == indexes[0] + indexes[1] * 100 + indexes[2] * 10000);
+            });
+            REQUIRE(visited == 3 * 4 * 1);
+            REQUIRE(visited_correct);
+        }
+    );
+}
+
+TEST(array_nd, function, convert_layout) {
+    gtl::array_nd<int, 0, 0> array_nd_column(37ull, 29ull);
+    for (unsigned long long int index2 = 0; index2 < 29; ++index2) {
+        for (unsigned long long int index1 = 0; index1 < 37; ++index1) {
+            array_nd_column(index1, index2) = static_cast<int>(index1 * 1000 + index2);
+        }
+    }
+
+    gtl::layout_array_nd<int, gtl::array_layout_tiled<8>, 0, 0> array_nd_tiled(37ull, 29ull);
+    gtl::convert_layout(array_nd_tiled, array_nd_column);
+
+    gtl::thread_pool thread_pool(2);
+    gtl::layout_array_nd<int, gtl::array_layout_morton, 0, 0> array_nd_morton(37ull, 29ull);
+    gtl::convert_layout(array_nd_morton, array_nd_tiled, thread_pool);
+    gtl::layout_array_nd<int, gtl::array_layout_row_major, 0, 0> array_nd_row(37ull, 29ull);
+    gtl::convert_layout(array_nd_row, array_nd_morton, thread_pool);
+    thread_pool.join();
+
+    bool converted = true;
+    for (unsigned long long int index2 = 0; index2 < 29; ++index2) {
+        for (unsigned long long int index1 = 0; index1 < 37; ++index1) {
+            converted &= (array_nd_tiled(index1, index2) == array_nd_column(index1, index2));
+            converted &= (array_nd_morton(index1, index2) == array_nd_column(index1, index2));
+            converted &= (array_nd_row(index1, index2) == array_nd_column(index1, index2));
+        }
+    }
+    REQUIRE(converted);
+    REQUIRE(array_nd_row.step(0) == 29);
+    REQUIRE(array_nd_row.data()[1] == array_nd_column(0ull, 1ull));
+}
@@ -0,0 +1,209 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <benchmark.tests.hpp>
+#include <require.tests.hpp>
+
+#include <container/array_view_nd>
+
+#if defined(_MSC_VER)
+#   pragma warning(push, 0)
+#endif
+
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+
+TEST(array_view_nd, traits, standard) {
+    REQUIRE(sizeof(gtl::array_view_nd<float, 1>) == sizeof(float*) + 16, "sizeof(gtl::array_view_nd<float, 1>) = %ld, expected == %lld", sizeof(gtl::array_view_nd<float, 1>), static_cast<unsigned long long int>(sizeof(float*) + 16));
+
+    REQUIRE(sizeof(gtl::array_view_nd<float, 3>) == sizeof(float*) + 48, "sizeof(gtl::array_view_nd<float, 3>) = %ld, expected == %lld", sizeof(gtl::array_view_nd<float, 3>), static_cast<unsigned long long int>(sizeof(float*) + 48));
+
+    REQUIRE((std::is_trivially_copyable<gtl::array_view_nd<float, 2>>::value == true), "Expected std::is_trivially_copyable to be true.");
+
+    REQUIRE((std::is_convertible<gtl::array_view_nd<float, 2>, gtl::array_view_nd<const float, 2>>::value == true), "Expected a mutable view to convert to a const view.");
+
+    REQUIRE((std::is_convertible<gtl::array_view_nd<const float, 2>, gtl::array_view_nd<float, 2>>::value == false), "Expected a const view not to convert to a mutable view.");
+}
+
+TEST(array_view_nd, constructor, empty) {
+    gtl::array_view_nd<int, 2> view;
+    REQUIRE(view.data() == nullptr);
+    REQUIRE(view.size() == 0);
+}
+
+TEST(array_view_nd, constructor, array_nd) {
+    gtl::array_nd<int, 0, 3> array(4ull);
+    for (unsigned long long int x = 0; x < 4; ++x) {
+        for (unsigned long long int y = 0; y < 3; ++y) {
+            array(x, y) = static_cast<int>(x * 10 + y);
+        }
+    }
+
+    gtl::array_view_nd<int, 2> view(array);
+    REQUIRE(view.size() == 12);
+    REQUIRE(view.size(0) == 4);
+    REQUIRE(view.size(1) == 3);
+    REQUIRE(view.stride(0) == 1);
+    REQUIRE(view.stride(1) == 4);
+    REQUIRE(view.is_contiguous());
+    for (unsigned long long int x = 0; x < 4; ++x) {
+        for (unsigned long long int y = 0; y < 3; ++y) {
+            REQUIRE(view(x, y) == array(x, y), "Element %llu, %llu differs.", x, y);
+        }
+    }
+
+    view(2, 1) = -1;
+    REQUIRE(array(2ull, 1ull) == -1, "Expected writes through the view to reach the array.");
+
+    const gtl::array_nd<int, 0, 3>& const_array = array;
+    gtl::array_view_nd<const int, 2> const_view(const_array);
+    REQUIRE(const_view(2, 1) == -1);
+}
+
+TEST(array_view_nd, constructor, static_array_nd) {
+    gtl::static_array_nd<int, 4, 3> array = {};
+    for (unsigned long long int x = 0; x < 4; ++x) {
+        for (unsigned long long int y = 0; y < 3; ++y) {
+            array(x, y) = static_cast<int>(x * 10 + y);
+        }
+    }
+
+    gtl::array_view_nd<int, 2> view(array);
+    REQUIRE(view.stride(0) == 3);
+    REQUIRE(view.stride(1) == 1);
+    REQUIRE(view.is_contiguous() == false, "Expected a static_array_nd not to be contiguous in array_nd order.");
+    REQUIRE(view.transpose().is_contiguous(), "Expected a transposed static_array_nd to be contiguous in array_nd order.");
+    for (unsigned long long int x = 0; x < 4; ++x) {
+        for (unsigned long long int y = 0; y < 3; ++y) {
+            REQUIRE(view(x, y) == array(x, y), "Element %llu, %llu differs.", x, y);
+        }
+    }
+}
+
+TEST(array_view_nd, constructor, pointer) {
+    int data[24] = {};
+    for (int index = 0; index < 24; ++index) {
+        data[index] = index;
+    }
+
+    // Every other element of a 4x6 buffer viewed as 2x6.
+    gtl::array_view_nd<int, 2> view(data, { 2, 6 }, { 2, 4 });
+    REQUIRE(view(1, 5) == 22);
+    REQUIRE(view(0, 1) == 4);
+
+    // Negative strides walk backwards.
+    gtl::array_view_nd<int, 1> reversed(&data[23], { 24 }, { -1 });
+    REQUIRE(reversed(0) == 23);
+    REQUIRE(reversed(23) == 0);
+}
+
+TEST(array_view_nd, function, slice) {
+    gtl::array_nd<int, 4, 5, 6> array;
+    for (unsigned long long int x = 0; x < 4; ++x) {
+        for (unsigned long long int y = 0; y < 5; ++y) {
+            for (unsigned long long int z = 0; z < 6; ++z) {
+                array(x, y, z) = static_cast<int>(x * 100 + y * 10 + z);
+            }
+        }
+    }
+    gtl::array_view_nd<int, 3> view(array);
+
+    gtl::array_view_nd<int, 2> plane = view.slice(1, 3);
+    REQUIRE(plane.size(0) == 4);
+    REQUIRE(plane.size(1) == 6);
+    for (unsigned long long int x = 0; x < 4; ++x) {
+        for (unsigned long long int z = 0; z < 6; ++z) {
+            REQUIRE(plane(x, z) == array(x, 3ull, z), "Element %llu, %llu differs.", x, z);
+        }
+    }
+
+    gtl::array_view_nd<int, 1> line = plane.slice(0, 2);
+    REQUIRE(line.size() == 6);
+    for (unsigned long long int z = 0; z < 6; ++z) {
+        REQUIRE(line(z) == array(2ull, 3ull, z), "Element %llu differs.", z);
+    }
+}
+
+TEST(array_view_nd, function, subarray) {
+    gtl::array_nd<int, 0, 0> array(8ull, 8ull);
+    for (unsigned long long int x = 0; x < 8; ++x) {
+        for (unsigned long long int y = 0; y < 8; ++y) {
+            array(x, y) = 0;
+        }
+    }
+    gtl::array_view_nd<int, 2> view(array);
+
+    // Update every 4x4 tile in place rather than copying it out and back.
+    for (unsigned long long int tile_x = 0; tile_x < 2; ++tile_x) {
+        for (unsigned long long int tile_y = 0; tile_y < 2; ++tile_y) {
+            gtl::array_view_nd<int, 2> tile = view.subarray({ { tile_x * 4, tile_x * 4 + 4 }, { tile_y * 4, tile_y * 4 + 4 } });
+            REQUIRE(tile.size(0) == 4);
+            REQUIRE(tile.size(1) == 4);
+            REQUIRE(tile.is_contiguous() == false);
+            for (unsigned long long int x = 0; x < 4; ++x) {
+                for (unsigned long long int y = 0; y < 4; ++y) {
+                    tile(x, y) += static_cast<int>(tile_x * 2 + tile_y + 1);
+                }
+            }
+        }
+    }
+
+    for (unsigned long long int x = 0; x < 8; ++x) {
+        for (unsigned long long int y = 0; y < 8; ++y) {
+            REQUIRE(array(x, y) == static_cast<int>((x / 4) * 2 + (y / 4) + 1), "Element %llu, %llu is wrong.", x, y);
+        }
+    }
+
+    gtl::array_view_nd<int, 2> empty = view.subarray({ { 3, 3 }, { 0, 8 } });
+    REQUIRE(empty.size() == 0);
+}
+
+TEST(array_view_nd, function, transpose) {
+    gtl::array_nd<int, 2, 3, 4> array;
+    for (unsigned long long int x = 0; x < 2; ++x) {
+        for (unsigned long long int y = 0; y < 3; ++y) {
+            for (unsigned long long int z = 0; z < 4; ++z) {
+                array(x, y, z) = static_cast<int>(x * 100 + y * 10 + z);
+            }
+        }
+    }
+    gtl::array_view_nd<int, 3> view(array);
+
+    gtl::array_view_nd<int, 3> reversed = view.transpose();
+    REQUIRE(reversed.size(0) == 4);
+    REQUIRE(reversed.size(2) == 2);
+    gtl::array_view_nd<int, 3> swapped = view.transpose(0, 1);
+    REQUIRE(swapped.size(0) == 3);
+    REQUIRE(swapped.size(1) == 2);
+    for (unsigned long long int x = 0; x < 2; ++x) {
+        for (unsigned long long int y = 0; y < 3; ++y) {
+            for (unsigned long long int z = 0; z < 4; ++z) {
+                REQUIRE(reversed(z, y, x) == array(x, y, z), "Element %llu, %llu, %llu differs.", x, y, z);
+                REQUIRE(swapped(y, x, z) == array(x, y, z), "Element %llu, %llu, %llu differs.", x, y, z);
+            }
+        }
+    }
+
+    REQUIRE(view.transpose().transpose().is_contiguous(), "Expected transposing twice to restore the layout.");
+}
@@ -0,0 +1,167 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <comparison.tests.hpp>
+#include <require.tests.hpp>
+
+#include <container/mapped_array_nd>
+
+#if defined(_MSC_VER)
+#   pragma warning(push, 0)
+#endif
+
+#include <cstddef>
+#include <cstdio>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+
+namespace {
+    constexpr static const char* test_path = "mapped_array_nd.test.bin";
+}
+
+TEST(mapped_array_nd, traits, standard) {
+    REQUIRE((std::is_copy_constructible<gtl::mapped_array_nd<float, 3>>::value == false), "Expected std::is_copy_constructible to be false.");
+    REQUIRE((std::is_move_constructible<gtl::mapped_array_nd<float, 3>>::value == true), "Expected std::is_move_constructible to be true.");
+    REQUIRE((gtl::mapped_array_nd<float, 3>::data_offset % 4096) == 0, "Expected the elements to be page aligned.");
+}
+
+TEST(mapped_array_nd, constructor, empty) {
+    gtl::mapped_array_nd<float, 3> mapped_array_nd;
+    REQUIRE(mapped_array_nd.is_open() == false);
+    REQUIRE(mapped_array_nd.size() == 0);
+    REQUIRE(mapped_array_nd.data() == nullptr);
+}
+
+TEST(mapped_array_nd, function, open) {
+    REQUIRE((gtl::mapped_array_nd<float, 3>::create(test_path, { 5, 6, 7 })));
+
+    {
+        gtl::mapped_array_nd<float, 3> mapped_array_nd(test_path, gtl::mapped_array_nd_mode::read_write);
+        REQUIRE(mapped_array_nd.is_open());
+        REQUIRE(mapped_array_nd.size() == 5 * 6 * 7);
+        REQUIRE(mapped_array_nd.size(0) == 5);
+        REQUIRE(mapped_array_nd.size(2) == 7);
+        REQUIRE(mapped_array_nd.step(2) == 30);
+        REQUIRE(mapped_array_nd(4ull, 5ull, 6ull) == 0.0f, "Expected new elements to be zero.");
+        for (unsigned long long int index3 = 0; index3 < 7; ++index3) {
+            for (unsigned long long int index2 = 0; index2 < 6; ++index2) {
+                for (unsigned long long int index1 = 0; index1 < 5; ++index1) {
+                    mapped_array_nd(index1, index2, index3) = static_cast<float>(index1 + index2 * 10 + index3 * 100);
+                }
+            }
+        }
+        REQUIRE(mapped_array_nd.flush());
+    }
+
+    // Another mapping sees the written elements.
+    gtl::mapped_array_nd<float, 3> mapped_array_nd(test_path);
+    REQUIRE(mapped_array_nd.is_open());
+    REQUIRE(mapped_array_nd.get_mode() == gtl::mapped_array_nd_mode::read_only);
+    REQUIRE(mapped_array_nd(3ull, 2ull, 1ull) == 123.0f);
+    REQUIRE(mapped_array_nd.view()(3, 2, 1) == 123.0f);
+    REQUIRE(mapped_array_nd.view().is_contiguous());
+
+    gtl::mapped_array_nd<float, 3> moved(std::move(mapped_array_nd));
+    REQUIRE(mapped_array_nd.is_open() == false);
+    REQUIRE(moved(4ull, 5ull, 6ull) == 654.0f);
+
+    std::remove(test_path);
+}
+
+TEST(mapped_array_nd, function, copy_on_write) {
+    REQUIRE((gtl::mapped_array_nd<int, 2>::create(test_path, { 100, 100 })));
+
+    {
+        gtl::mapped_array_nd<int, 2> mapped_array_nd(test_path, gtl::mapped_array_nd_mode::copy_on_write);
+        REQUIRE(mapped_array_nd.is_open());
+        mapped_array_nd(10ull, 20ull) = 42;
+        REQUIRE(mapped_array_nd(10ull, 20ull) == 42);
+
+        // Private writes are not seen by other mappings.
+        gtl::mapped_array_nd<int, 2> other(test_path);
+        REQUIRE(other(10ull, 20ull) == 0);
+    }
+
+    // Nor do they reach the file.
+    gtl::mapped_array_nd<int, 2> mapped_array_nd(test_path);
+    REQUIRE(mapped_array_nd(10ull, 20ull) == 0);
+
+    std::remove(test_path);
+}
+
+TEST(mapped_array_nd, function, validation) {
+    REQUIRE((gtl::mapped_array_nd<float, 2>::create(test_path, { 8, 8 })));
+
+    // The element type and number of dimensions must match the file.
+    REQUIRE((gtl::mapped_array_nd<float, 2>(test_path).is_open() == true));
+    REQUIRE((gtl::mapped_array_nd<int, 2>(test_path).is_open() == false));
+    REQUIRE((gtl::mapped_array_nd<double, 2>(test_path).is_open() == false));
+    REQUIRE((gtl::mapped_array_nd<float, 3>(test_path).is_open() == false));
+
+    // Missing and truncated files are rejected.
+    REQUIRE((gtl::mapped_array_nd<float, 2>("mapped_array_nd.missing.bin").is_open() == false));
+    std::FILE* file = std::fopen(test_path, "wb");
+    std::fwrite("GTLARRND", 1, 8, file);
+    std::fclose(file);
+    REQUIRE((gtl::mapped_array_nd<float, 2>(test_path).is_open() == false));
+
+    // Empty dimensions cannot be created.
+    REQUIRE((gtl::mapped_array_nd<float, 2>::create(test_path, { 8, 0 }) == false));
+
+    // Nor can sizes whose file would not fit in 64 bits.
+    REQUIRE((gtl::mapped_array_nd<float, 2>::create(test_path, { 1ull << 32, 1ull << 32 }) == false));
+
+    // A header claiming more elements than fit in 64 bits is rejected rather than wrapping to a small size.
+    REQUIRE((gtl::mapped_array_nd<float, 2>::create(test_path, { 4, 4 })));
+    REQUIRE((gtl::mapped_array_nd<float, 2>(test_path).is_open() == true));
+    using header_type = gtl::mapped_array_nd<float, 2>::header;
+    const unsigned long long int overflowing_sizes[2] = { 1ull << 32, 1ull << 32 };
+    file = std::fopen(test_path, "r+b");
+    std::fseek(file, static_cast<long>(offsetof(header_type, sizes)), SEEK_SET);
+    std::fwrite(overflowing_sizes, sizeof(overflowing_sizes), 1, file);
+    std::fclose(file);
+    REQUIRE((gtl::mapped_array_nd<float, 2>(test_path).is_open() == false));
+
+    std::remove(test_path);
+}
+
+TEST(mapped_array_nd, function, advise) {
+    REQUIRE((gtl::mapped_array_nd<double, 3>::create(test_path, { 64, 64, 64 })));
+
+    gtl::mapped_array_nd<double, 3> mapped_array_nd(test_path);
+    REQUIRE(mapped_array_nd.is_open());
+#if (defined(linux) || defined(__linux) || defined(__linux__)) || defined(__APPLE__)
+    REQUIRE(mapped_array_nd.advise(gtl::mapped_array_nd_advice::sequential));
+    REQUIRE(mapped_array_nd.advise(gtl::mapped_array_nd_advice::random));
+    REQUIRE(mapped_array_nd.advise(gtl::mapped_array_nd_advice::normal));
+    REQUIRE(mapped_array_nd.prefetch({ 0, 0, 10 }, { 64, 64, 20 }));
+    REQUIRE(mapped_array_nd.prefetch({ 10, 10, 10 }, { 20, 20, 20 }));
+    REQUIRE(mapped_array_nd.prefetch({ 0, 0, 0 }, { 64, 64, 64 }));
+    REQUIRE(mapped_array_nd.prefetch({ 5, 5, 5 }, { 5, 6, 6 }), "Expected an empty region to succeed.");
+#endif
+    REQUIRE(mapped_array_nd(63ull, 63ull, 63ull) == 0.0);
+
+    std::remove(test_path);
+}
@@ -0,0 +1,259 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <benchmark.tests.hpp>
+#include <comparison.tests.hpp>
+#include <print.tests.hpp>
+#include <require.tests.hpp>
+
+#include <container/sparse_array_nd>
+
+#if defined(_MSC_VER)
+#   pragma warning(push, 0)
+#endif
+
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+
+TEST(sparse_array_nd, traits, standard) {
+    REQUIRE((std::is_copy_constructible<gtl::sparse_array_nd<float, 3>>::value == true), "Expected std::is_copy_constructible to be true.");
+    REQUIRE((std::is_move_constructible<gtl::sparse_array_nd<float, 3>>::value == true), "Expected std::is_move_constructible to be true.");
+    REQUIRE((gtl::sparse_array_nd<float, 3>::brick_volume == 512), "Expected 8x8x8 bricks by default.");
+    REQUIRE((gtl::sparse_array_nd<float, 2, 16>::brick_volume == 256));
+}
+
+TEST(sparse_array_nd, constructor, empty) {
+    gtl::sparse_array_nd<float, 3> sparse_array_nd;
+    REQUIRE(sparse_array_nd.size() == 0);
+    REQUIRE(sparse_array_nd.brick_total() == 0);
+    REQUIRE(sparse_array_nd.allocated_bricks() == 0);
+}
+
+TEST(sparse_array_nd, constructor, sizes) {
+    gtl::sparse_array_nd<float, 3> sparse_array_nd(100, 200, 300);
+    REQUIRE(sparse_array_nd.size() == 100 * 200 * 300);
+    REQUIRE(sparse_array_nd.size(1) == 200);
+    REQUIRE(sparse_array_nd.brick_total() == 13 * 25 * 38);
+    REQUIRE(sparse_array_nd.allocated_bricks() == 0);
+    REQUIRE(sparse_array_nd.get(99, 199, 299) == 0.0f);
+    REQUIRE(sparse_array_nd.memory_size() < sparse_array_nd.size() * sizeof(float) / 50, "Expected an unwritten array to use a small fraction of the dense size.");
+}
+
+TEST(sparse_array_nd, function, indexing) {
+    gtl::sparse_array_nd<int, 3> sparse_array_nd(30, 20, 10);
+
+    // Reading and writing the uniform value does not allocate.
+    REQUIRE(sparse_array_nd.get(5, 5, 5) == 0);
+    sparse_array_nd.set(0, 5, 5, 5);
+    REQUIRE(sparse_array_nd.allocated_bricks() == 0);
+    const gtl::sparse_array_nd<int, 3>& const_sparse_array_nd = sparse_array_nd;
+    REQUIRE(const_sparse_array_nd(29, 19, 9) == 0);
+    REQUIRE(sparse_array_nd.allocated_bricks() == 0);
+
+    sparse_array_nd.set(7, 5, 5, 5);
+    REQUIRE(sparse_array_nd.allocated_bricks() == 1);
+    sparse_array_nd(29, 19, 9) = 9;
+    REQUIRE(sparse_array_nd.allocated_bricks() == 2);
+    REQUIRE(sparse_array_nd.get(5, 5, 5) == 7);
+    REQUIRE(sparse_array_nd.get(5, 5, 6) == 0);
+    REQUIRE(sparse_array_nd.get(29, 19, 9) == 9);
+    const unsigned long long int indexes[3] = { 29, 19, 9 };
+    REQUIRE(const_sparse_array_nd(indexes) == 9);
+
+    // Every element is independently addressable.
+    for (unsigned long long int index3 = 0; index3 < 10; ++index3) {
+        for (unsigned long long int index2 = 0; index2 < 20; ++index2) {
+            for (unsigned long long int index1 = 0; index1 < 30; ++index1) {
+                sparse_array_nd(index1, index2, index3) = static_cast<int>(index1 + index2 * 100 + index3 * 10000);
+            }
+        }
+    }
+    REQUIRE(sparse_array_nd.allocated_bricks() == sparse_array_nd.brick_total());
+    bool matches = true;
+    for (unsigned long long int index3 = 0; index3 < 10; ++index3) {
+        for (unsigned long long int index2 = 0; index2 < 20; ++index2) {
+            for (unsigned long long int index1 = 0; index1 < 30; ++index1) {
+                matches &= (sparse_array_nd.get(index1, index2, index3) == static_cast<int>(index1 + index2 * 100 + index3 * 10000));
+            }
+        }
+    }
+    REQUIRE(matches);
+}
+
+TEST(sparse_array_nd, function, fill) {
+    gtl::sparse_array_nd<float, 3> sparse_array_nd(64, 64, 64);
+
+    // Covered bricks become uniform without allocating, partially covered bricks are allocated.
+    sparse_array_nd.fill({ 0, 0, 0 }, { 32, 64, 64 }, 1.0f);
+    REQUIRE(sparse_array_nd.allocated_bricks() == 0);
+    REQUIRE(sparse_array_nd.get(31, 63, 63) == 1.0f);
+    REQUIRE(sparse_array_nd.get(32, 63, 63) == 0.0f);
+    sparse_array_nd.fill({ 4, 4, 4 }, { 12, 12, 12 }, 2.0f);
+    REQUIRE(sparse_array_nd.allocated_bricks() == 8);
+    REQUIRE(sparse_array_nd.get(3, 4, 4) == 1.0f);
+    REQUIRE(sparse_array_nd.get(4, 4, 4) == 2.0f);
+    REQUIRE(sparse_array_nd.get(11, 11, 11) == 2.0f);
+    REQUIRE(sparse_array_nd.get(12, 11, 11) == 1.0f);
+
+    // Filling over allocated bricks frees them.
+    sparse_array_nd.fill({ 0, 0, 0 }, { 16, 16, 16 }, 3.0f);
+    REQUIRE(sparse_array_nd.allocated_bricks() == 0);
+    REQUIRE(sparse_array_nd.get(4, 4, 4) == 3.0f);
+
+    sparse_array_nd(1, 2, 3) = 4.0f;
+    sparse_array_nd.fill(5.0f);
+    REQUIRE(sparse_array_nd.allocated_bricks() == 0);
+    REQUIRE(sparse_array_nd.get(1, 2, 3) == 5.0f);
+
+    // Filling from an element of the array itself reads it before its brick is freed.
+    sparse_array_nd.set(42.0f, 1, 2, 3);
+    sparse_array_nd.fill(sparse_array_nd.get(1, 2, 3));
+    REQUIRE(sparse_array_nd.get(60, 60, 60) == 42.0f);
+    sparse_array_nd.set(6.0f, 1, 2, 3);
+    sparse_array_nd.fill({ 0, 0, 0 }, { 8, 8, 8 }, sparse_array_nd.get(1, 2, 3));
+    REQUIRE(sparse_array_nd.allocated_bricks() == 0);
+    REQUIRE(sparse_array_nd.get(7, 7, 7) == 6.0f);
+    REQUIRE(sparse_array_nd.get(8, 7, 7) == 42.0f);
+
+    // A bool array holds its uniform values unpacked, so reads return references to them.
+    gtl::sparse_array_nd<bool, 2> mask(20, 20);
+    mask.fill({ 0, 0 }, { 16, 16 }, true);
+    const bool& value = mask.get(3, 3);
+    REQUIRE(value == true);
+    REQUIRE(mask.get(17, 17) == false);
+    REQUIRE(mask.allocated_bricks() == 0);
+}
+
+TEST(sparse_array_nd, function, fill_region) {
+    // Sizes that are not multiples of the brick size, so regions end part way through edge bricks.
+    gtl::sparse_array_nd<int, 3> sparse_array_nd(19, 13, 21);
+    sparse_array_nd.fill({ 3, 5, 7 }, { 17, 13, 9 }, 7);
+    sparse_array_nd.fill({ 18, 12, 20 }, { 19, 13, 21 }, 9);
+    REQUIRE(sparse_array_nd.allocated_bricks() == 13, "Expected only the bricks the regions partially cover to be allocated, not %llu.", sparse_array_nd.allocated_bricks());
+    bool matches = true;
+    for (unsigned long long int index3 = 0; index3 < 21; ++index3) {
+        for (unsigned long long int index2 = 0; index2 < 13; ++index2) {
+            for (unsigned long long int index1 = 0; index1 < 19; ++index1) {
+                int expected = 0;
+                if ((index1 >= 3) && (index1 < 17) && (index2 >= 5) && (index3 >= 7) && (index3 < 9)) {
+                    expected = 7;
+                }
+                if ((index1 == 18) && (index2 == 12) && (index3 == 20)) {
+                    expected = 9;
+                }
+                matches &= (sparse_array_nd.get(index1, index2, index3) == expected);
+            }
+        }
+    }
+    REQUIRE(matches == true, "Expected exactly the filled regions to hold their values.");
+}
+
+TEST(sparse_array_nd, function, compact) {
+    gtl::sparse_array_nd<int, 2> sparse_array_nd(20, 20);
+    sparse_array_nd(1, 1) = 1;
+    sparse_array_nd(10, 10) = 1;
+    sparse_array_nd(19, 19) = 1;
+    REQUIRE(sparse_array_nd.allocated_bricks() == 3);
+
+    // Restoring a brick to a single value lets it be freed.
+    sparse_array_nd(1, 1) = 0;
+    REQUIRE(sparse_array_nd.compact() == 1);
+    REQUIRE(sparse_array_nd.allocated_bricks() == 2);
+
+    // The padding of an edge brick does not prevent it being freed.
+    for (unsigned long long int index2 = 16; index2 < 20; ++index2) {
+        for (unsigned long long int index1 = 16; index1 < 20; ++index1) {
+            sparse_array_nd(index1, index2) = 1;
+        }
+    }
+    REQUIRE(sparse_array_nd.compact() == 1);
+    REQUIRE(sparse_array_nd.allocated_bricks() == 1);
+    REQUIRE(sparse_array_nd.get(16, 16) == 1);
+    REQUIRE(sparse_array_nd.get(10, 10) == 1);
+    REQUIRE(sparse_array_nd.get(11, 10) == 0);
+}
+
+TEST(sparse_array_nd, function, for_each_allocated) {
+    gtl::sparse_array_nd<int, 3> sparse_array_nd(100, 100, 100);
+    sparse_array_nd.fill({ 0, 0, 0 }, { 100, 100, 48 }, 1);
+    sparse_array_nd(10, 20, 30) = 2;
+    sparse_array_nd(99, 99, 99) = 3;
+
+    // Only the two allocated bricks are visited, the edge brick only within the array.
+    unsigned long long int count = 0;
+    int sum = 0;
+    sparse_array_nd.for_each_allocated([&](const unsigned long long int(&indexes)[3], int& value) {
+        ++count;
+        sum += value;
+        value += static_cast<int>(indexes[0] == 99);
+    });
+    REQUIRE(count == 8 * 8 * 8 + 4 * 4 * 4, "Expected %llu elements to be visited, not %llu.", 8ull * 8 * 8 + 4 * 4 * 4, count);
+    REQUIRE(sum == (8 * 8 * 8 - 1) + 2 + 3);
+    REQUIRE(sparse_array_nd.get(99, 99, 99) == 4);
+
+    const gtl::sparse_array_nd<int, 3> copy(sparse_array_nd);
+    REQUIRE(copy.allocated_bricks() == 2);
+    int maximum = 0;
+    copy.for_each_allocated([&](const unsigned long long int(&)[3], const int& value) {
+        maximum = (value > maximum) ? value : maximum;
+    });
+    REQUIRE(maximum == 4);
+
+    gtl::sparse_array_nd<int, 3> moved(std::move(sparse_array_nd));
+    REQUIRE(moved.allocated_bricks() == 2);
+    REQUIRE(moved.get(10, 20, 30) == 2);
+    REQUIRE(moved.get(10, 20, 60) == 0);
+}
+
+TEST(sparse_array_nd, evaluation, memory) {
+    // A 256^3 volume with a sphere shell written to it.
+    gtl::sparse_array_nd<float, 3> sparse_array_nd(256, 256, 256);
+    for (unsigned long long int index3 = 0; index3 < 256; ++index3) {
+        for (unsigned long long int index2 = 0; index2 < 256; ++index2) {
+            for (unsigned long long int index1 = 0; index1 < 256; ++index1) {
+                const long long int x = static_cast<long long int>(index1) - 128;
+                const long long int y = static_cast<long long int>(index2) - 128;
+                const long long int z = static_cast<long long int>(index3) - 128;
+                const long long int distance = x * x + y * y + z * z;
+                if ((distance >= 100 * 100) && (distance < 102 * 102)) {
+                    sparse_array_nd(index1, index2, index3) = 1.0f;
+                }
+            }
+        }
+    }
+    const unsigned long long int dense_size = sparse_array_nd.size() * sizeof(float);
+    PRINT("Allocated %llu of %llu bricks, %llu of %llu bytes.\n", sparse_array_nd.allocated_bricks(), sparse_array_nd.brick_total(), sparse_array_nd.memory_size(), dense_size);
+    REQUIRE(sparse_array_nd.memory_size() < dense_size / 4, "Expected the shell to use a small fraction of the dense size.");
+
+    const gtl::sparse_array_nd<float, 3>& const_sparse_array_nd = sparse_array_nd;
+    auto result = testbench::benchmark<void>([&]() {
+        float sum = 0.0f;
+        for (unsigned long long int index = 0; index < 256; ++index) {
+            sum += const_sparse_array_nd(index, index, 128);
+        }
+        testbench::do_not_optimise_away(sum);
+    }, 1000, 0.1);
+    PRINT("Diagonal read: %.1fns\n", result.first);
+}
@@ -452,3 +452,105 @@ TEST(static_array_nd, operator, parenthesis) {
     );
 }
 
+
+namespace {
+    constexpr static const auto crc_table = gtl::make_static_array_nd<unsigned int, 256>([](unsigned long long index) {
+        unsigned int value = static_cast<unsigned int>(index);
+        for (unsigned int bit = 0; bit < 8; ++bit) {
+            value = (value & 1) ? ((value >> 1) ^ 0xEDB88320u) : (value >> 1);
+        }
+        return value;
+    });
+}
+
+TEST(static_array_nd, function, fill) {
+    constexpr static const auto filled = []() {
+        gtl::static_array_nd<int, 3, 4, 5> array = {};
+        array.fill(7);
+        return array;
+    }();
+    static_assert(filled(2, 3, 4) == 7, "Expected fill to run at compile time.");
+
+    gtl::static_array_nd<float, 6, 2> array;
+    array.fill(1.5f);
+    REQUIRE(array.reduce(0.0f, [](float lhs, float rhs) { return lhs + rhs; }) == 18.0f);
+}
+
+TEST(static_array_nd, function, generate) {
+    // A lookup table built at compile time.
+    static_assert(crc_table(0) == 0x00000000u, "Expected the table to be built at compile time.");
+    static_assert(crc_table(1) == 0x77073096u, "Expected the table to be built at compile time.");
+    static_assert(crc_table(255) == 0x2D02EF8Du, "Expected the table to be built at compile time.");
+    unsigned int crc = 0xFFFFFFFFu;
+    for (const char* character = "123456789"; *character; ++character) {
+        crc = crc_table((crc ^ static_cast<unsigned char>(*character)) & 0xFF) ^ (crc >> 8);
+    }
+    REQUIRE((crc ^ 0xFFFFFFFFu) == 0xCBF43926u, "Expected the check value of CRC-32.");
+
+    // Each value is given the index of every dimension.
+    constexpr static const auto indexed = gtl::make_static_array_nd<unsigned long long, 4, 3, 2>([](unsigned long long index1, unsigned long long index2, unsigned long long index3) {
+        return index1 * 100 + index2 * 10 + index3;
+    });
+    static_assert(indexed(3, 2, 1) == 321, "Expected generate to pass every index.");
+    REQUIRE(indexed(1, 0, 1) == 101);
+}
+
+TEST(static_array_nd, function, transform) {
+    constexpr static const auto weights = []() {
+        gtl::static_array_nd<float, 2, 4> array = {};
+        array.transform(gtl::make_static_array_nd<int, 2, 4>([](unsigned long long row, unsigned long long column) {
+            return static_cast<int>(row * 4 + column);
+        }), [](int value) {
+            return static_cast<float>(value) / 8.0f;
+        });
+        return array;
+    }();
+    static_assert(weights(1, 3) == 0.875f, "Expected transform to run at compile time.");
+
+    gtl::static_array_nd<int, 5> array = { { 1, 2, 3, 4, 5 } };
+    array.transform(array, [](int value) { return value * value; });
+    REQUIRE(array(4) == 25);
+}
+
+TEST(static_array_nd, function, reduce) {
+    constexpr static const unsigned long long sum = gtl::make_static_array_nd<unsigned long long, 10, 10>([](unsigned long long index1, unsigned long long index2) {
+        return index1 * 10 + index2;
+    }).reduce(0ull, [](unsigned long long lhs, unsigned long long rhs) {
+        return lhs + rhs;
+    });
+    static_assert(sum == 4950, "Expected reduce to run at compile time.");
+
+    // Values are visited in order with the last dimension fastest.
+    constexpr static const auto digits = gtl::make_static_array_nd<unsigned long long, 2, 3>([](unsigned long long index1, unsigned long long index2) {
+        return index1 * 3 + index2 + 1;
+    });
+    REQUIRE(digits.reduce(0ull, [](unsigned long long lhs, unsigned long long rhs) { return lhs * 10 + rhs; }) == 123456);
+    REQUIRE((gtl::static_array_nd<int, 0>().reduce(3, [](int lhs, int rhs) { return lhs + rhs; }) == 3));
+}
+
+TEST(static_array_nd, function, matrix_multiply) {
+    constexpr static const gtl::static_array_nd<int, 2, 3> lhs = { { { { 1, 2, 3 } }, { { 4, 5, 6 } } } };
+    constexpr static const gtl::static_array_nd<int, 3, 2> rhs = { { { { 7, 8 } }, { { 9, 10 } }, { { 11, 12 } } } };
+    constexpr static const gtl::static_array_nd<int, 2, 2> product = gtl::matrix_multiply(lhs, rhs);
+    static_assert(product(0, 0) == 58, "Expected matrix_multiply to run at compile time.");
+    static_assert(product(0, 1) == 64, "Expected matrix_multiply to run at compile time.");
+    static_assert(product(1, 0) == 139, "Expected matrix_multiply to run at compile time.");
+    static_assert(product(1, 1) == 154, "Expected matrix_multiply to run at compile time.");
+
+    gtl::static_array_nd<double, 3, 3> identity = {};
+    identity.generate([](unsigned long long row, unsigned long long column) {
+        return (row == column) ? 1.0 : 0.0;
+    });
+    gtl::static_array_nd<double, 3, 3> matrix = {};
+    matrix.generate([](unsigned long long row, unsigned long long column) {
+        return static_cast<double>(row * 3 + column);
+    });
+    const gtl::static_array_nd<double, 3, 3> result = gtl::matrix_multiply(matrix, identity);
+    bool matches = true;
+    for (unsigned long long row = 0; row < 3; ++row) {
+        for (unsigned long long column = 0; column < 3; ++column) {
+            matches &= (result(row, column) == matrix(row, column));
+        }
+    }
+    REQUIRE(matches);
+}
@@ -31,6 +31,7 @@ THE SOFTWARE
 #include <atomic>
 #include <thread>
 #include <type_traits>
+#include <vector>
 
 #if defined(_MSC_VER)
 #   pragma warning(pop)
@@ -58,6 +59,11 @@ TEST(barrier, constructor, value) {
     testbench::do_not_optimise_away(barrier);
 }
 
+TEST(barrier, constructor, value_and_completion) {
+    gtl::barrier barrier(1, [](){});
+    testbench::do_not_optimise_away(barrier);
+}
+
 TEST(barrier, function, get_and_set_trigger_count) {
     gtl::barrier barrier;
     REQUIRE(barrier.get_trigger_count() == 0, "Expected the trigger count of an empty barrier to be %d, not %lld", 0, barrier.get_trigger_count());
@@ -80,6 +86,27 @@ TEST(barrier, function, sync) {
     barrier.sync();
 }
 
+TEST(barrier, function, arrive_and_wait) {
+    gtl::barrier barrier(1);
+    gtl::barrier::arrival_token token = barrier.arrive();
+    barrier.wait(token);
+}
+
+TEST(barrier, function, completion) {
+    int completed = 0;
+    gtl::barrier barrier(1, [&completed](){ ++completed; });
+    barrier.sync();
+    barrier.sync();
+    REQUIRE(completed == 2, "Expected the completion function to run %d times, not %d.", 2, completed);
+}
+
+TEST(barrier, function, trigger_before_sync) {
+    gtl::barrier barrier(2);
+    barrier.trigger();
+    barrier.sync();
+    REQUIRE(barrier.get_waiting_count() == 0, "Expected the waiting count after a triggered sync to be %d, not %lld", 0, barrier.get_waiting_count());
+}
+
 TEST(barrier, evaluation, set_trigger_count_with_two_threads) {
     gtl::barrier barrier(2);
 
@@ -162,3 +189,34 @@ TEST(barrier, evaluation, sync_with_two_threads) {
 
     REQUIRE(result == 2, "Expected result to be set to 1 not '%d' after join.", result.load());
 }
+
+TEST(barrier, evaluation, arrive_and_wait_with_completion) {
+    constexpr static const unsigned long long int thread_count = 4;
+    constexpr static const unsigned long long int phase_count = 1000;
+
+    unsigned long long int completed = 0;
+    gtl::barrier barrier(thread_count, [&completed](){ ++completed; });
+
+    std::atomic<bool> completed_once = true;
+
+    std::vector<std::thread> threads;
+    for (unsigned long long int thread_index = 0; thread_index < thread_count; ++thread_index) {
+        threads.emplace_back([&barrier, &completed, &completed_once](){
+            for (unsigned long long int phase = 1; phase <= phase_count; ++phase) {
+                gtl::barrier::arrival_token token = barrier.arrive();
+                barrier.wait(token);
+                // The completion function has run exactly once for every phase so far, and the next cannot complete without this thread.
+                if (completed != 2 * phase - 1) {
+                    completed_once = false;
+                }
+                barrier.sync();
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(completed_once == true, "Expected the completion function to run once per phase.");
+    REQUIRE(completed == 2 * phase_count, "Expected the completion function to run %lld times, not %lld.", 2 * phase_count, completed);
+}
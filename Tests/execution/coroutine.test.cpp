@@ -22,6 +22,7 @@ THE SOFTWARE
 #include <benchmark.tests.hpp>
 #include <data.tests.hpp>
 #include <require.tests.hpp>
+#include <print.tests.hpp>
 #include <template.tests.hpp>
 
 #include <execution/coroutine>
@@ -30,7 +31,21 @@ THE SOFTWARE
 #   pragma warning(push, 0)
 #endif
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <type_traits>
+#include <vector>
+
+#if defined(linux) || defined(__linux) || defined(__linux__)
+#   include <ucontext.h>
+#   include <unistd.h>
+#endif
 
 #if defined(_MSC_VER)
 #   pragma warning(pop)
@@ -38,12 +53,10 @@ THE SOFTWARE
 
 TEST(coroutine, traits, standard) {
 
-    #if defined(__APPLE__)
-        REQUIRE(sizeof(gtl::coroutine) == 352, "sizeof(gtl::coroutine) = %ld, expected == %lld", sizeof(gtl::coroutine), 352ull);
-    #elif defined(__linux__)
-        REQUIRE(sizeof(gtl::coroutine) == 576 || sizeof(gtl::coroutine) == 584, "sizeof(gtl::coroutine) = %ld, expected == %lld", sizeof(gtl::coroutine), 576ull);
+    #if defined(__APPLE__) || defined(__linux__)
+        REQUIRE(sizeof(gtl::coroutine) == 56 || sizeof(gtl::coroutine) == 64, "sizeof(gtl::coroutine) = %ld, expected == %lld", sizeof(gtl::coroutine), 56ull);
     #elif defined(_WIN32)
-        REQUIRE(sizeof(gtl::coroutine) == 28, "sizeof(gtl::coroutine) = %ld, expected == %lld", sizeof(gtl::coroutine), 28ull);
+        REQUIRE(sizeof(gtl::coroutine) == 20, "sizeof(gtl::coroutine) = %ld, expected == %lld", sizeof(gtl::coroutine), 20ull);
     #endif
 
     REQUIRE(std::is_pod<gtl::coroutine>::value == false, "Expected std::is_pod to be false.");
@@ -80,6 +93,51 @@ TEST(coroutine, constructor, lamda_argument) {
     );
 }
 
+TEST(coroutine, constructor, stack_size_lambda) {
+    gtl::coroutine coroutine(gtl::coroutine::stack_size(1024 * 1024), [](){
+        // Use most of a stack that is far larger than the default.
+        volatile unsigned char buffer[768 * 1024];
+        for (unsigned long long int index = 0; index < sizeof(buffer); index += 4096) {
+            buffer[index] = static_cast<unsigned char>(index);
+        }
+    });
+    coroutine.join();
+}
+
+TEST(coroutine, constructor, stack_size_lamda_argument) {
+    int result = 0;
+    gtl::coroutine coroutine(gtl::coroutine::stack_size(1), [](int* output, int value){ *output = value; }, &result, 1);
+    coroutine.join();
+    REQUIRE(result == 1, "Expected result to be set to 1 not '%d' after coroutine run.", result);
+}
+
+TEST(coroutine, constructor, move_only_function) {
+    int result = 0;
+    std::unique_ptr<int> value(new int(3));
+    gtl::coroutine coroutine([&result, value = std::move(value)](std::unique_ptr<int>& argument){ result = *value + *argument; }, std::unique_ptr<int>(new int(4)));
+    coroutine.join();
+    REQUIRE(result == 7, "Expected result to be set to 7 not '%d' after coroutine run.", result);
+}
+
+TEST(coroutine, constructor, function_destroyed_on_return) {
+    std::shared_ptr<int> value = std::make_shared<int>(1);
+    gtl::coroutine coroutine([value](){ gtl::this_coroutine::yield(); });
+    REQUIRE(value.use_count() == 2, "Expected the coroutine to hold a copy of the function, use count is %ld.", value.use_count());
+    coroutine.join();
+    REQUIRE(value.use_count() == 2, "Expected the suspended coroutine to still hold the function, use count is %ld.", value.use_count());
+    coroutine.join();
+    REQUIRE(value.use_count() == 1, "Expected the function to be destroyed when it returns, use count is %ld.", value.use_count());
+}
+
+TEST(coroutine, constructor, large_function) {
+    unsigned char buffer[8 * 1024] = {};
+    buffer[sizeof(buffer) - 1] = 5;
+    int result = 0;
+    gtl::coroutine coroutine(gtl::coroutine::stack_size(32 * 1024), [buffer, &result](){ result = buffer[sizeof(buffer) - 1]; });
+    coroutine.join();
+    REQUIRE(result == 5, "Expected result to be set to 5 not '%d' after coroutine run.", result);
+}
+
 TEST(coroutine, constructor, move) {
     gtl::coroutine coroutine1([](){});
     gtl::coroutine coroutine2(std::move(coroutine1));
@@ -104,6 +162,20 @@ TEST(coroutine, function, get_id) {
     coroutine2.join();
 }
 
+TEST(coroutine, function, get_id_reused_stack) {
+    gtl::coroutine::id id;
+    {
+        gtl::coroutine coroutine([](){});
+        id = coroutine.get_id();
+        coroutine.join();
+    }
+    gtl::coroutine coroutine([](){});
+    #if !defined(_WIN32)
+        REQUIRE(coroutine.get_id() == id, "Expected a new coroutine to reuse the stack of a destroyed coroutine.");
+    #endif
+    coroutine.join();
+}
+
 TEST(coroutine, function, joinable) {
     gtl::coroutine coroutine1;
     REQUIRE(coroutine1.joinable() == false, "Extected joinable() to be false for an empty coroutine.");
@@ -113,6 +185,49 @@ TEST(coroutine, function, joinable) {
     coroutine2.join();
 }
 
+TEST(coroutine, function, valid) {
+    gtl::coroutine coroutine1;
+    REQUIRE(coroutine1.valid() == false, "Expected valid() to be false for an empty coroutine.");
+    gtl::coroutine coroutine2([](){});
+    REQUIRE(coroutine2.valid() == true, "Expected valid() to be true for a coroutine with a stack.");
+    coroutine2.join();
+    REQUIRE(coroutine2.valid() == true, "Expected valid() to stay true after the coroutine has finished.");
+    gtl::coroutine coroutine3(std::move(coroutine2));
+    REQUIRE(coroutine3.valid() == true, "Expected valid() to move with the coroutine.");
+    REQUIRE(coroutine2.valid() == false, "Expected valid() to be false for a moved from coroutine.");
+}
+
+TEST(coroutine, function, destroyed_after_stack_pool) {
+    struct late_holder final {
+        std::unique_ptr<gtl::coroutine> routine;
+
+        // A user provided constructor makes the thread local below dynamically initialised, so it is constructed before and destroyed after the stack pool.
+        late_holder()
+            : routine() {
+        }
+    };
+
+    std::thread thread([](){
+        static thread_local late_holder late;
+        late.routine.reset(new gtl::coroutine([](){}));
+        late.routine->join();
+    });
+    thread.join();
+}
+
+TEST(coroutine, function, abandon) {
+    bool resumed = false;
+    gtl::coroutine coroutine([&resumed](){
+        gtl::this_coroutine::yield();
+        resumed = true;
+    });
+    coroutine.join();
+    REQUIRE(coroutine.joinable() == true, "Expected the coroutine to be unfinished after yielding.");
+    coroutine.abandon();
+    REQUIRE(coroutine.joinable() == false, "Expected an abandoned coroutine not to be joinable.");
+    REQUIRE(resumed == false, "Expected an abandoned coroutine not to be resumed.");
+}
+
 TEST(coroutine, function, join) {
     bool result = false;
     gtl::coroutine coroutine([&result](){
@@ -147,6 +262,44 @@ TEST(coroutine, function, current_yield) {
     REQUIRE(result == 2, "Expected result to be set to 2 not '%d' after coroutine run.", result);
 }
 
+TEST(coroutine, function, nested_join) {
+    int result = 0;
+    gtl::coroutine outer([&result](){
+        gtl::coroutine inner([&result](){
+            result = 1;
+            gtl::this_coroutine::yield();
+            result = 3;
+        });
+        inner.join();
+        REQUIRE(result == 1, "Expected result to be set to 1 not '%d' after inner coroutine yield.", result);
+        result = 2;
+        gtl::this_coroutine::yield();
+        inner.join();
+    });
+    outer.join();
+    REQUIRE(result == 2, "Expected result to be set to 2 not '%d' after outer coroutine yield.", result);
+    outer.join();
+    REQUIRE(result == 3, "Expected result to be set to 3 not '%d' after coroutine run.", result);
+}
+
+TEST(coroutine, function, move_while_suspended) {
+    int result = 0;
+    gtl::coroutine coroutine1([&result](){
+        double value = 0.5;
+        for (int index = 0; index < 10; ++index) {
+            value *= 2.0;
+            gtl::this_coroutine::yield();
+        }
+        result = static_cast<int>(value);
+    });
+    coroutine1.join();
+    gtl::coroutine coroutine2(std::move(coroutine1));
+    while (coroutine2.joinable()) {
+        coroutine2.join();
+    }
+    REQUIRE(result == 512, "Expected result to be set to 512 not '%d' after coroutine run.", result);
+}
+
 TEST(coroutine, function, current_sleep_for) {
     gtl::coroutine coroutine([](){
         gtl::this_coroutine::sleep_for(std::chrono::milliseconds(100));
@@ -160,3 +313,208 @@ TEST(coroutine, function, current_sleep_until) {
     });
     coroutine.join();
 }
+
+#if defined(linux) || defined(__linux) || defined(__linux__)
+namespace {
+    // The number of bytes of the process that are resident in memory.
+    unsigned long long int get_resident_bytes() {
+        unsigned long long int total_pages = 0;
+        unsigned long long int resident_pages = 0;
+        std::FILE* statm = std::fopen("/proc/self/statm", "r");
+        if (statm != nullptr) {
+            if (std::fscanf(statm, "%llu %llu", &total_pages, &resident_pages) != 2) {
+                resident_pages = 0;
+            }
+            std::fclose(statm);
+        }
+        return resident_pages * static_cast<unsigned long long int>(sysconf(_SC_PAGESIZE));
+    }
+
+    // The resident bytes gained for each of a number of items between two measurements, memory given back in between counts as none gained.
+    double get_resident_bytes_each(unsigned long long int start_bytes, unsigned long long int end_bytes, unsigned long long int count) {
+        const long long int gained_bytes = static_cast<long long int>(end_bytes) - static_cast<long long int>(start_bytes);
+        return (gained_bytes > 0) ? static_cast<double>(gained_bytes) / static_cast<double>(count) : 0.0;
+    }
+
+    // A bare ucontext switch pair, used as the baseline the coroutine switch is compared against, the callee returns to the caller through uc_link.
+    ucontext_t ucontext_caller;
+    ucontext_t ucontext_callee;
+    volatile bool ucontext_running = false;
+
+    void ucontext_entry() {
+        while (ucontext_running) {
+            swapcontext(&ucontext_callee, &ucontext_caller);
+        }
+    }
+}
+#endif
+
+TEST(coroutine, evaluation, create_run_destroy) {
+    const std::pair<double, unsigned long long int> coroutine_result = testbench::benchmark<void>([](){
+        gtl::coroutine coroutine([](){});
+        coroutine.join();
+    }, 1000, 0.1);
+    PRINT("Coroutine create, run and destroy:   %12.1f ns (%llu iterations)\n", coroutine_result.first, coroutine_result.second);
+
+    const std::pair<double, unsigned long long int> thread_result = testbench::benchmark<void>([](){
+        std::thread thread([](){});
+        thread.join();
+    }, 100, 0.1);
+    PRINT("Thread create, run and destroy:      %12.1f ns (%llu iterations)\n", thread_result.first, thread_result.second);
+
+#if defined(linux) || defined(__linux) || defined(__linux__)
+    const std::pair<double, unsigned long long int> ucontext_result = testbench::benchmark<void>([](){
+        constexpr static const unsigned long long int stack_size = gtl::coroutine::default_stack_size;
+        void* stack = std::malloc(stack_size);
+        getcontext(&ucontext_callee);
+        ucontext_callee.uc_stack.ss_sp = stack;
+        ucontext_callee.uc_stack.ss_size = stack_size;
+        ucontext_callee.uc_link = &ucontext_caller;
+        makecontext(&ucontext_callee, &ucontext_entry, 0);
+        ucontext_running = false;
+        swapcontext(&ucontext_caller, &ucontext_callee);
+        std::free(stack);
+    }, 1000, 0.1);
+    PRINT("Ucontext create, run and destroy:    %12.1f ns (%llu iterations)\n", ucontext_result.first, ucontext_result.second);
+
+#   if !defined(GTL_COROUTINE_USE_UCONTEXT) && (defined(__x86_64__) || defined(__aarch64__))
+        // A pooled stack and the assembly switch make a coroutine several times cheaper to create than a ucontext with a new stack.
+        REQUIRE(coroutine_result.first < ucontext_result.first, "Expected a coroutine (%.1f ns) to be cheaper to create than a ucontext (%.1f ns).", coroutine_result.first, ucontext_result.first);
+#   endif
+#endif
+
+    // The margins are wide so the gates hold on a busy host, a coroutine is normally around a hundred times cheaper to create than a thread.
+    REQUIRE(coroutine_result.first * 4.0 < thread_result.first, "Expected a coroutine (%.1f ns) to be at least four times cheaper to create than a thread (%.1f ns).", coroutine_result.first, thread_result.first);
+}
+
+TEST(coroutine, evaluation, yield_round_trip) {
+    bool coroutine_running = true;
+    gtl::coroutine coroutine([&coroutine_running](){
+        while (coroutine_running) {
+            gtl::this_coroutine::yield();
+        }
+    });
+    const std::pair<double, unsigned long long int> coroutine_result = testbench::benchmark<void>([&coroutine](){
+        coroutine.join();
+    }, 100000, 0.1);
+    coroutine_running = false;
+    coroutine.join();
+    PRINT("Coroutine join and yield round trip: %12.1f ns (%llu iterations)\n", coroutine_result.first, coroutine_result.second);
+
+    // Two threads taking turns through a condition variable.
+    std::mutex mutex;
+    std::condition_variable condition;
+    unsigned long long int turn = 0;
+    bool thread_running = true;
+    std::thread thread([&](){
+        std::unique_lock<std::mutex> lock(mutex);
+        while (thread_running) {
+            condition.wait(lock, [&](){ return ((turn & 1) == 1) || !thread_running; });
+            ++turn;
+            condition.notify_one();
+        }
+    });
+    const std::pair<double, unsigned long long int> thread_result = testbench::benchmark<void>([&](){
+        std::unique_lock<std::mutex> lock(mutex);
+        ++turn;
+        condition.notify_one();
+        condition.wait(lock, [&](){ return (turn & 1) == 0; });
+    }, 1000, 0.1);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        thread_running = false;
+    }
+    condition.notify_one();
+    thread.join();
+    PRINT("Thread condition variable round trip: %11.1f ns (%llu iterations)\n", thread_result.first, thread_result.second);
+
+#if defined(linux) || defined(__linux) || defined(__linux__)
+    std::vector<unsigned char> stack(gtl::coroutine::default_stack_size);
+    getcontext(&ucontext_callee);
+    ucontext_callee.uc_stack.ss_sp = stack.data();
+    ucontext_callee.uc_stack.ss_size = stack.size();
+    ucontext_callee.uc_link = &ucontext_caller;
+    makecontext(&ucontext_callee, &ucontext_entry, 0);
+    ucontext_running = true;
+    const std::pair<double, unsigned long long int> ucontext_result = testbench::benchmark<void>([](){
+        swapcontext(&ucontext_caller, &ucontext_callee);
+    }, 100000, 0.1);
+    ucontext_running = false;
+    swapcontext(&ucontext_caller, &ucontext_callee);
+    PRINT("Ucontext swapcontext round trip:     %12.1f ns (%llu iterations)\n", ucontext_result.first, ucontext_result.second);
+
+#   if !defined(GTL_COROUTINE_USE_UCONTEXT) && (defined(__x86_64__) || defined(__aarch64__))
+        // The assembly backend exists to avoid the system call swapcontext makes to save the signal mask.
+        REQUIRE(coroutine_result.first < ucontext_result.first, "Expected a coroutine switch (%.1f ns) to be faster than a ucontext switch (%.1f ns).", coroutine_result.first, ucontext_result.first);
+#   endif
+#endif
+
+    // A thread round trip needs the kernel to switch threads, which is normally tens of times slower than a coroutine switch.
+    REQUIRE(coroutine_result.first * 4.0 < thread_result.first, "Expected a coroutine switch (%.1f ns) to be at least four times faster than a thread switch (%.1f ns).", coroutine_result.first, thread_result.first);
+}
+
+#if defined(linux) || defined(__linux) || defined(__linux__)
+TEST(coroutine, evaluation, memory_per_coroutine) {
+    constexpr static const unsigned long long int coroutine_count = 1000;
+    constexpr static const unsigned long long int thread_count = 64;
+    constexpr static const double gigabyte = 1024.0 * 1024.0 * 1024.0;
+
+    // Every coroutine is started so its stack has been touched, then left suspended.
+    const unsigned long long int coroutine_start = get_resident_bytes();
+    {
+        bool running = true;
+        std::vector<gtl::coroutine> coroutines;
+        coroutines.reserve(coroutine_count);
+        for (unsigned long long int index = 0; index < coroutine_count; ++index) {
+            coroutines.emplace_back([&running](){
+                while (running) {
+                    gtl::this_coroutine::yield();
+                }
+            });
+            coroutines.back().join();
+        }
+        const unsigned long long int coroutine_end = get_resident_bytes();
+        const double coroutine_bytes = get_resident_bytes_each(coroutine_start, coroutine_end, coroutine_count);
+        PRINT("Coroutine resident memory:           %12.1f bytes, %.0f per GB\n", coroutine_bytes, gigabyte / coroutine_bytes);
+        // The reserved address space does not depend on the host, it is a default stack and its guard page.
+        const unsigned long long int reserved_bytes = gtl::coroutine::default_stack_size + static_cast<unsigned long long int>(sysconf(_SC_PAGESIZE));
+        PRINT("Coroutine reserved memory:           %12llu bytes, %.0f per GB of address space\n", reserved_bytes, gigabyte / static_cast<double>(reserved_bytes));
+        REQUIRE(gigabyte / static_cast<double>(reserved_bytes) >= 4096.0, "Expected at least 4096 coroutines per GB of address space, not %.0f.", gigabyte / static_cast<double>(reserved_bytes));
+        running = false;
+        for (gtl::coroutine& coroutine : coroutines) {
+            coroutine.join();
+        }
+
+        // Every thread is started and left waiting.
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool waiting = true;
+        std::atomic<unsigned long long int> started(0);
+        const unsigned long long int thread_start = get_resident_bytes();
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count);
+        for (unsigned long long int index = 0; index < thread_count; ++index) {
+            threads.emplace_back([&](){
+                ++started;
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [&](){ return !waiting; });
+            });
+        }
+        while (started < thread_count) {
+            std::this_thread::yield();
+        }
+        const unsigned long long int thread_end = get_resident_bytes();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            waiting = false;
+        }
+        condition.notify_all();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        const double thread_bytes = get_resident_bytes_each(thread_start, thread_end, thread_count);
+        PRINT("Thread resident memory:              %12.1f bytes, %.0f per GB\n", thread_bytes, gigabyte / thread_bytes);
+        PRINT("Ucontext context size:               %12llu bytes, plus a caller allocated stack\n", static_cast<unsigned long long int>(sizeof(ucontext_t)));
+    }
+}
+#endif
@@ -0,0 +1,139 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <benchmark.tests.hpp>
+#include <require.tests.hpp>
+
+#include <execution/coroutine_channel>
+
+#if defined(_MSC_VER)
+#   pragma warning(push, 0)
+#endif
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+
+TEST(coroutine_channel, traits, standard) {
+    REQUIRE(sizeof(gtl::coroutine_channel<int>) >= 1, "sizeof(gtl::coroutine_channel<int>) = %ld, expected >= %lld", sizeof(gtl::coroutine_channel<int>), 1ull);
+
+    REQUIRE(std::is_pod<gtl::coroutine_channel<int>>::value == false, "Expected std::is_pod to be false.");
+
+    REQUIRE(std::is_trivial<gtl::coroutine_channel<int>>::value == false, "Expected std::is_trivial to be false.");
+
+    REQUIRE(std::is_trivially_copyable<gtl::coroutine_channel<int>>::value == false, "Expected std::is_trivially_copyable to be false.");
+}
+
+TEST(coroutine_channel, constructor, capacity) {
+    gtl::coroutine_channel<int> coroutine_channel(4);
+    REQUIRE(coroutine_channel.get_capacity() == 4, "Expected the capacity to be %d, not %lld.", 4, coroutine_channel.get_capacity());
+    REQUIRE(coroutine_channel.size() == 0, "Expected the channel to be empty.");
+}
+
+TEST(coroutine_channel, function, try_send_and_receive) {
+    gtl::coroutine_channel<int> coroutine_channel(2);
+    REQUIRE(coroutine_channel.try_send(1) == true, "Expected to send into an empty channel.");
+    REQUIRE(coroutine_channel.try_send(2) == true, "Expected to send into a channel with space.");
+    REQUIRE(coroutine_channel.try_send(3) == false, "Expected not to send into a full channel.");
+    int value = 0;
+    REQUIRE((coroutine_channel.try_receive(value) == true) && (value == 1), "Expected to receive %d, not %d.", 1, value);
+    REQUIRE((coroutine_channel.try_receive(value) == true) && (value == 2), "Expected to receive %d, not %d.", 2, value);
+    REQUIRE(coroutine_channel.try_receive(value) == false, "Expected not to receive from an empty channel.");
+}
+
+TEST(coroutine_channel, function, producer_consumer) {
+    constexpr static const int value_count = 1000;
+    gtl::coroutine_scheduler coroutine_scheduler;
+    gtl::coroutine_channel<int> coroutine_channel(3);
+    std::vector<int> received;
+    coroutine_scheduler.spawn([&](){
+        int value = 0;
+        while (coroutine_channel.receive(value)) {
+            REQUIRE(coroutine_channel.size() < 3, "Expected the channel to never hold more than its capacity.");
+            received.push_back(value);
+        }
+    });
+    coroutine_scheduler.spawn([&](){
+        for (int value = 0; value < value_count; ++value) {
+            REQUIRE(coroutine_channel.send(value) == true, "Expected to send into an open channel.");
+        }
+        coroutine_channel.close();
+        REQUIRE(coroutine_channel.send(value_count) == false, "Expected not to send into a closed channel.");
+    });
+    coroutine_scheduler.run();
+    REQUIRE(received.size() == static_cast<unsigned long long int>(value_count), "Expected to receive %d values, not %ld.", value_count, received.size());
+    for (int value = 0; value < value_count; ++value) {
+        REQUIRE(received[static_cast<unsigned long long int>(value)] == value, "Expected the values to be received in order.");
+    }
+}
+
+TEST(coroutine_channel, function, many_producers_many_consumers) {
+    constexpr static const int producer_count = 4;
+    constexpr static const int value_count = 250;
+    gtl::coroutine_scheduler coroutine_scheduler;
+    gtl::coroutine_channel<int> coroutine_channel(1);
+    int producers_running = producer_count;
+    long long int sum = 0;
+    int received_count = 0;
+    for (int consumer = 0; consumer < 3; ++consumer) {
+        coroutine_scheduler.spawn([&](){
+            int value = 0;
+            while (coroutine_channel.receive(value)) {
+                sum += value;
+                ++received_count;
+            }
+        });
+    }
+    for (int producer = 0; producer < producer_count; ++producer) {
+        coroutine_scheduler.spawn([&](){
+            for (int value = 1; value <= value_count; ++value) {
+                coroutine_channel.send(value);
+            }
+            if (--producers_running == 0) {
+                coroutine_channel.close();
+            }
+        });
+    }
+    coroutine_scheduler.run();
+    const long long int expected_sum = static_cast<long long int>(producer_count) * value_count * (value_count + 1) / 2;
+    REQUIRE(received_count == producer_count * value_count, "Expected to receive %d values, not %d.", producer_count * value_count, received_count);
+    REQUIRE(sum == expected_sum, "Expected the values to sum to %lld, not %lld.", expected_sum, sum);
+}
+
+TEST(coroutine_channel, function, move_only) {
+    gtl::coroutine_scheduler coroutine_scheduler;
+    gtl::coroutine_channel<std::unique_ptr<int>> coroutine_channel;
+    int result = 0;
+    coroutine_scheduler.spawn([&](){
+        std::unique_ptr<int> value;
+        REQUIRE(coroutine_channel.receive(value) == true, "Expected to receive a value.");
+        result = *value;
+    });
+    coroutine_scheduler.spawn([&](){
+        coroutine_channel.send(std::unique_ptr<int>(new int(7)));
+    });
+    coroutine_scheduler.run();
+    REQUIRE(result == 7, "Expected to receive %d, not %d.", 7, result);
+}
@@ -0,0 +1,109 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <benchmark.tests.hpp>
+#include <require.tests.hpp>
+
+#include <execution/coroutine_mutex>
+
+#if defined(_MSC_VER)
+#   pragma warning(push, 0)
+#endif
+
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+
+TEST(coroutine_mutex, traits, standard) {
+    REQUIRE(sizeof(gtl::coroutine_mutex) >= 1, "sizeof(gtl::coroutine_mutex) = %ld, expected >= %lld", sizeof(gtl::coroutine_mutex), 1ull);
+
+    REQUIRE(std::is_pod<gtl::coroutine_mutex>::value == false, "Expected std::is_pod to be false.");
+
+    REQUIRE(std::is_trivial<gtl::coroutine_mutex>::value == false, "Expected std::is_trivial to be false.");
+
+    REQUIRE(std::is_trivially_copyable<gtl::coroutine_mutex>::value == false, "Expected std::is_trivially_copyable to be false.");
+}
+
+TEST(coroutine_mutex, constructor, empty) {
+    gtl::coroutine_mutex coroutine_mutex;
+    testbench::do_not_optimise_away(coroutine_mutex);
+}
+
+TEST(coroutine_mutex, function, try_lock) {
+    gtl::coroutine_mutex coroutine_mutex;
+    REQUIRE(coroutine_mutex.try_lock() == true, "Expected to lock an unlocked mutex.");
+    REQUIRE(coroutine_mutex.try_lock() == false, "Expected not to lock a locked mutex.");
+    coroutine_mutex.unlock();
+    REQUIRE(coroutine_mutex.is_locked() == false, "Expected the mutex to be unlocked.");
+}
+
+TEST(coroutine_mutex, function, lock_across_yields) {
+    gtl::coroutine_scheduler coroutine_scheduler;
+    gtl::coroutine_mutex coroutine_mutex;
+    int inside = 0;
+    int maximum_inside = 0;
+    int completed = 0;
+    for (int index = 0; index < 8; ++index) {
+        coroutine_scheduler.spawn([&](){
+            for (int iteration = 0; iteration < 10; ++iteration) {
+                coroutine_mutex.lock();
+                ++inside;
+                maximum_inside = (inside > maximum_inside) ? inside : maximum_inside;
+                gtl::this_coroutine::yield();
+                --inside;
+                coroutine_mutex.unlock();
+                gtl::this_coroutine::yield();
+            }
+            ++completed;
+        });
+    }
+    coroutine_scheduler.run();
+    REQUIRE(maximum_inside == 1, "Expected only one coroutine to hold the lock at a time, not %d.", maximum_inside);
+    REQUIRE(completed == 8, "Expected %d coroutines to complete, not %d.", 8, completed);
+    REQUIRE(coroutine_mutex.is_locked() == false, "Expected the mutex to be unlocked.");
+}
+
+TEST(coroutine_mutex, function, fifo_hand_off) {
+    gtl::coroutine_scheduler coroutine_scheduler;
+    gtl::coroutine_mutex coroutine_mutex;
+    std::vector<int> order;
+    coroutine_scheduler.spawn([&](){
+        coroutine_mutex.lock();
+        gtl::this_coroutine::yield();
+        gtl::this_coroutine::yield();
+        REQUIRE(coroutine_mutex.get_waiting_count() == 3, "Expected %d waiting coroutines, not %lld.", 3, coroutine_mutex.get_waiting_count());
+        coroutine_mutex.unlock();
+        // The lock was handed over, so it cannot be taken back before the waiters have had it.
+        REQUIRE(coroutine_mutex.try_lock() == false, "Expected the lock to be handed to a waiter.");
+    });
+    for (int index = 0; index < 3; ++index) {
+        coroutine_scheduler.spawn([&, index](){
+            coroutine_mutex.lock();
+            order.push_back(index);
+            coroutine_mutex.unlock();
+        });
+    }
+    coroutine_scheduler.run();
+    REQUIRE((order == std::vector<int>{ 0, 1, 2 }), "Expected the waiters to take the lock in order.");
+}
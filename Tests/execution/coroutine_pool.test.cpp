@@ -0,0 +1,222 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <benchmark.tests.hpp>
+#include <require.tests.hpp>
+
+#include <execution/coroutine_pool>
+
+#if defined(_MSC_VER)
+#   pragma warning(push, 0)
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+
+TEST(coroutine_pool, traits, standard) {
+    REQUIRE(sizeof(gtl::coroutine_pool) >= 1, "sizeof(gtl::coroutine_pool) = %ld, expected >= %lld", sizeof(gtl::coroutine_pool), 1ull);
+
+    REQUIRE(std::is_pod<gtl::coroutine_pool>::value == false, "Expected std::is_pod to be false.");
+
+    REQUIRE(std::is_trivial<gtl::coroutine_pool>::value == false, "Expected std::is_trivial to be false.");
+
+    REQUIRE(std::is_trivially_copyable<gtl::coroutine_pool>::value == false, "Expected std::is_trivially_copyable to be false.");
+}
+
+TEST(coroutine_pool, constructor, thread_pool) {
+    gtl::thread_pool thread_pool(2);
+    {
+        gtl::coroutine_pool coroutine_pool(thread_pool, 3);
+        REQUIRE(coroutine_pool.get_worker_count() == 3, "Expected %d workers, not %lld.", 3, coroutine_pool.get_worker_count());
+        REQUIRE(coroutine_pool.get_task_count() == 0, "Expected the task count to be %d, not %lld.", 0, coroutine_pool.get_task_count());
+    }
+    thread_pool.join();
+}
+
+TEST(coroutine_pool, function, spawn_and_run) {
+    gtl::thread_pool thread_pool(3);
+    {
+        gtl::coroutine_pool coroutine_pool(thread_pool, 4);
+        std::atomic<int> sum(0);
+        for (int value = 1; value <= 100; ++value) {
+            coroutine_pool.spawn([&sum](int coroutine_value) {
+                gtl::this_coroutine::yield();
+                sum += coroutine_value;
+            }, value);
+        }
+        coroutine_pool.run();
+        REQUIRE(sum == 5050, "Expected the sum to be %d, not %d.", 5050, sum.load());
+        REQUIRE(coroutine_pool.get_task_count() == 0, "Expected the task count to be %d, not %lld.", 0, coroutine_pool.get_task_count());
+    }
+    thread_pool.join();
+}
+
+TEST(coroutine_pool, function, spawn_without_threads) {
+    gtl::thread_pool thread_pool(0);
+    gtl::coroutine_pool coroutine_pool(thread_pool, 4);
+    std::atomic<int> count(0);
+    for (int index = 0; index < 10; ++index) {
+        coroutine_pool.spawn([&count, &coroutine_pool]() {
+            // Spawning from a coroutine queues on the worker running it.
+            coroutine_pool.spawn([&count]() {
+                ++count;
+            });
+            gtl::this_coroutine::yield();
+            ++count;
+        });
+    }
+    coroutine_pool.run();
+    REQUIRE(count == 20, "Expected %d coroutines to run, not %d.", 20, count.load());
+}
+
+TEST(coroutine_pool, function, resume_on_any_thread) {
+    gtl::thread_pool thread_pool(3);
+    {
+        gtl::coroutine_pool coroutine_pool(thread_pool, 4);
+        std::mutex thread_mutex;
+        std::set<std::thread::id> thread_ids;
+        std::atomic<int> mismatches(0);
+        for (int index = 0; index < 16; ++index) {
+            coroutine_pool.spawn([&]() {
+                gtl::coroutine* self = gtl::this_coroutine::get_self();
+                gtl::coroutine_pool::task_handle task = gtl::coroutine_pool::get_running_task();
+                for (int iteration = 0; iteration < 1000; ++iteration) {
+                    gtl::this_coroutine::yield();
+                    // After every resume the thread locals must describe the thread now running the coroutine.
+                    if ((gtl::this_coroutine::get_self() != self) || (gtl::coroutine_pool::get_running_task() != task) || (gtl::coroutine_pool::get_current() != &coroutine_pool)) {
+                        ++mismatches;
+                    }
+                    if ((iteration % 100) == 0) {
+                        std::lock_guard<std::mutex> lock(thread_mutex);
+                        thread_ids.insert(std::this_thread::get_id());
+                    }
+                }
+            });
+        }
+        coroutine_pool.run();
+        REQUIRE(mismatches == 0, "Expected the thread locals to follow the coroutine, found %d mismatches.", mismatches.load());
+        REQUIRE(thread_ids.size() >= 1, "Expected the coroutines to run on at least one thread.");
+    }
+    thread_pool.join();
+}
+
+TEST(coroutine_pool, function, wake_from_another_thread) {
+    gtl::thread_pool thread_pool(2);
+    {
+        gtl::coroutine_pool coroutine_pool(thread_pool, 3);
+        std::mutex handle_mutex;
+        std::vector<gtl::coroutine_pool::task_handle> handles;
+        std::atomic<int> woken(0);
+        constexpr static const int task_count = 32;
+        for (int index = 0; index < task_count; ++index) {
+            coroutine_pool.spawn([&]() {
+                {
+                    std::lock_guard<std::mutex> lock(handle_mutex);
+                    handles.push_back(gtl::coroutine_pool::get_running_task());
+                }
+                // The waker can wake the task before it has finished parking.
+                gtl::coroutine_pool::park();
+                ++woken;
+            });
+        }
+        std::thread waker([&]() {
+            int wake_count = 0;
+            while (wake_count < task_count) {
+                gtl::coroutine_pool::task_handle handle = nullptr;
+                {
+                    std::lock_guard<std::mutex> lock(handle_mutex);
+                    if (!handles.empty()) {
+                        handle = handles.back();
+                        handles.pop_back();
+                    }
+                }
+                if (handle != nullptr) {
+                    coroutine_pool.wake(handle);
+                    ++wake_count;
+                }
+                else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        coroutine_pool.run();
+        waker.join();
+        REQUIRE(woken == task_count, "Expected %d coroutines to be woken, not %d.", task_count, woken.load());
+    }
+    thread_pool.join();
+}
+
+TEST(coroutine_pool, function, sleep_for) {
+    gtl::thread_pool thread_pool(2);
+    {
+        gtl::coroutine_pool coroutine_pool(thread_pool, 3);
+        std::atomic<int> woken(0);
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int index = 0; index < 100; ++index) {
+            coroutine_pool.spawn([&woken, index]() {
+                gtl::this_coroutine::sleep_for(std::chrono::milliseconds(10 + index % 10));
+                ++woken;
+            });
+        }
+        coroutine_pool.run();
+        const std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+        REQUIRE(woken == 100, "Expected %d coroutines to wake, not %d.", 100, woken.load());
+        REQUIRE(elapsed >= std::chrono::milliseconds(10), "Expected the coroutines to sleep.");
+        REQUIRE(elapsed < std::chrono::seconds(2), "Expected the sleeping coroutines to share the workers rather than sleeping them in turn.");
+    }
+    thread_pool.join();
+}
+
+TEST(coroutine_pool, evaluation, uneven_load) {
+    gtl::thread_pool thread_pool(3);
+    {
+        gtl::coroutine_pool coroutine_pool(thread_pool, 4);
+        std::atomic<unsigned long long int> total(0);
+        // All the work starts on one worker, the others must steal it.
+        coroutine_pool.spawn([&]() {
+            for (int index = 0; index < 1000; ++index) {
+                coroutine_pool.spawn(gtl::coroutine::stack_size(16 * 1024), [&total]() {
+                    unsigned long long int value = 0;
+                    for (int iteration = 0; iteration < 10; ++iteration) {
+                        for (int step = 0; step < 1000; ++step) {
+                            value += static_cast<unsigned long long int>(step);
+                            testbench::do_not_optimise_away(value);
+                        }
+                        gtl::this_coroutine::yield();
+                    }
+                    total += value;
+                });
+            }
+        });
+        coroutine_pool.run();
+        REQUIRE(total == 1000ull * 10ull * 499500ull, "Expected the total to be %lld, not %lld.", 1000ull * 10ull * 499500ull, total.load());
+    }
+    thread_pool.join();
+}
@@ -0,0 +1,235 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <benchmark.tests.hpp>
+#include <require.tests.hpp>
+
+#include <execution/coroutine_scheduler>
+
+#if defined(_MSC_VER)
+#   pragma warning(push, 0)
+#endif
+
+#include <chrono>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+
+TEST(coroutine_scheduler, traits, standard) {
+    REQUIRE(sizeof(gtl::coroutine_scheduler) >= 1, "sizeof(gtl::coroutine_scheduler) = %ld, expected >= %lld", sizeof(gtl::coroutine_scheduler), 1ull);
+
+    REQUIRE(std::is_pod<gtl::coroutine_scheduler>::value == false, "Expected std::is_pod to be false.");
+
+    REQUIRE(std::is_trivial<gtl::coroutine_scheduler>::value == false, "Expected std::is_trivial to be false.");
+
+    REQUIRE(std::is_trivially_copyable<gtl::coroutine_scheduler>::value == false, "Expected std::is_trivially_copyable to be false.");
+}
+
+TEST(coroutine_scheduler, constructor, empty) {
+    gtl::coroutine_scheduler coroutine_scheduler;
+    testbench::do_not_optimise_away(coroutine_scheduler);
+}
+
+TEST(coroutine_scheduler, function, spawn_and_run) {
+    gtl::coroutine_scheduler coroutine_scheduler;
+    int result = 0;
+    coroutine_scheduler.spawn([&result](int value){ result = value; }, 1);
+    REQUIRE(coroutine_scheduler.get_task_count() == 1, "Expected the task count to be %d, not %lld.", 1, coroutine_scheduler.get_task_count());
+    coroutine_scheduler.run();
+    REQUIRE(coroutine_scheduler.get_task_count() == 0, "Expected the task count to be %d, not %lld.", 0, coroutine_scheduler.get_task_count());
+    REQUIRE(result == 1, "Expected result to be set to 1 not '%d' after the scheduler run.", result);
+}
+
+TEST(coroutine_scheduler, function, spawn_with_stack_size) {
+    gtl::coroutine_scheduler coroutine_scheduler;
+    int result = 0;
+    coroutine_scheduler.spawn(gtl::coroutine::stack_size(16 * 1024), [&result](){ result = 1; });
+    coroutine_scheduler.run();
+    REQUIRE(result == 1, "Expected result to be set to 1 not '%d' after the scheduler run.", result);
+}
+
+TEST(coroutine_scheduler, function, yield_round_robin) {
+    gtl::coroutine_scheduler coroutine_scheduler;
+    std::vector<int> order;
+    for (int index = 0; index < 3; ++index) {
+        coroutine_scheduler.spawn([&order, index](){
+            order.push_back(index);
+            gtl::this_coroutine::yield();
+            order.push_back(index + 3);
+        });
+    }
+    coroutine_scheduler.run();
+    for (int index = 0; index < 6; ++index) {
+        REQUIRE(order[static_cast<unsigned long long int>(index)] == index, "Expected the coroutines to run in order, position %d holds %d.", index, order[static_cast<unsigned long long int>(index)]);
+    }
+}
+
+TEST(coroutine_scheduler, function, sleep_for_order) {
+    gtl::coroutine_scheduler coroutine_scheduler;
+    std::vector<int> order;
+    for (int index = 3; index > 0; --index) {
+        coroutine_scheduler.spawn([&order, index](){
+            gtl::this_coroutine::sleep_for(std::chrono::milliseconds(10 * index));
+            order.push_back(index);
+        });
+    }
+    coroutine_scheduler.spawn([&order](){
+        order.push_back(0);
+    });
+    coroutine_scheduler.run();
+    for (int index = 0; index < 4; ++index) {
+        REQUIRE(order[static_cast<unsigned long long int>(index)] == index, "Expected the coroutines to wake in order, position %d holds %d.", index, order[static_cast<unsigned long long int>(index)]);
+    }
+}
+
+TEST(coroutine_scheduler, function, sleep_until) {
+    gtl::coroutine_scheduler coroutine_scheduler;
+    const std::chrono::system_clock::time_point wake_time = std::chrono::system_clock::now() + std::chrono::milliseconds(10);
+    bool woken = false;
+    coroutine_scheduler.spawn([&woken, wake_time](){
+        gtl::this_coroutine::sleep_until(wake_time);
+        woken = true;
+    });
+    coroutine_scheduler.run();
+    REQUIRE(woken == true, "Expected the coroutine to wake.");
+}
+
+TEST(coroutine_scheduler, function, park_and_wake) {
+    gtl::coroutine_scheduler coroutine_scheduler;
+    gtl::coroutine_scheduler::task_handle parked_task = nullptr;
+    std::vector<int> order;
+    coroutine_scheduler.spawn([&coroutine_scheduler, &parked_task, &order](){
+        REQUIRE(gtl::coroutine_scheduler::get_current() == &coroutine_scheduler, "Expected the running scheduler to be current.");
+        parked_task = coroutine_scheduler.get_running_task();
+        order.push_back(0);
+        coroutine_scheduler.park();
+        order.push_back(3);
+    });
+    coroutine_scheduler.spawn([&coroutine_scheduler, &parked_task, &order](){
+        order.push_back(1);
+        gtl::this_coroutine::yield();
+        gtl::this_coroutine::yield();
+        order.push_back(2);
+        coroutine_scheduler.wake(parked_task);
+    });
+    REQUIRE(coroutine_scheduler.run() == true, "Expected every coroutine to finish.");
+    REQUIRE(gtl::coroutine_scheduler::get_current() == nullptr, "Expected no scheduler to be current after running.");
+    REQUIRE((order == std::vector<int>{ 0, 1, 2, 3 }), "Expected the parked coroutine to wait until it was woken.");
+}
+
+TEST(coroutine_scheduler, function, poll_hook) {
+    struct event_loop {
+        gtl::coroutine_scheduler* scheduler;
+        gtl::coroutine_scheduler::task_handle parked_task;
+        int poll_count;
+
+        static bool poll(void* context, int timeout_milliseconds) {
+            event_loop* self = static_cast<event_loop*>(context);
+            if (self->parked_task == nullptr) {
+                return false;
+            }
+            ++self->poll_count;
+            if (timeout_milliseconds != 0) {
+                self->scheduler->wake(self->parked_task);
+                self->parked_task = nullptr;
+            }
+            return true;
+        }
+    };
+
+    gtl::coroutine_scheduler coroutine_scheduler;
+    event_loop loop = { &coroutine_scheduler, nullptr, 0 };
+    coroutine_scheduler.set_poll_hook(&event_loop::poll, &loop);
+    bool woken = false;
+    coroutine_scheduler.spawn([&coroutine_scheduler, &loop, &woken](){
+        loop.parked_task = coroutine_scheduler.get_running_task();
+        coroutine_scheduler.park();
+        woken = true;
+    });
+    coroutine_scheduler.run();
+    REQUIRE(woken == true, "Expected the poll hook to wake the parked coroutine.");
+    REQUIRE(loop.poll_count == 1, "Expected the poll hook to wait once, not %d times.", loop.poll_count);
+}
+
+TEST(coroutine_scheduler, function, deadlock) {
+    gtl::coroutine_scheduler coroutine_scheduler;
+    gtl::coroutine_scheduler::task_handle parked_task = nullptr;
+    bool woken = false;
+    coroutine_scheduler.spawn([&coroutine_scheduler, &parked_task, &woken](){
+        parked_task = coroutine_scheduler.get_running_task();
+        coroutine_scheduler.park();
+        woken = true;
+    });
+    REQUIRE(coroutine_scheduler.run() == false, "Expected the run to stop when the only coroutine is parked.");
+    REQUIRE(gtl::coroutine_scheduler::get_current() == nullptr, "Expected no scheduler to be current after a deadlock.");
+    REQUIRE(coroutine_scheduler.get_task_count() == 1, "Expected the parked coroutine to remain.");
+    REQUIRE(woken == false, "Expected the parked coroutine not to have been run.");
+
+    coroutine_scheduler.wake(parked_task);
+    REQUIRE(coroutine_scheduler.run() == true, "Expected the run to finish once the coroutine was woken.");
+    REQUIRE(woken == true, "Expected the woken coroutine to finish.");
+}
+
+TEST(coroutine_scheduler, function, destroy_unfinished) {
+    int finished_count = 0;
+    {
+        gtl::coroutine_scheduler coroutine_scheduler;
+        // Parked and never woken.
+        coroutine_scheduler.spawn([&coroutine_scheduler, &finished_count](){
+            coroutine_scheduler.park();
+            ++finished_count;
+        });
+        coroutine_scheduler.spawn([&finished_count](){
+            ++finished_count;
+        });
+        REQUIRE(coroutine_scheduler.run() == false, "Expected the run to stop when the only unfinished coroutine is parked.");
+        REQUIRE(finished_count == 1, "Expected only the coroutine that was not parked to finish.");
+        // Never run.
+        coroutine_scheduler.spawn([&finished_count](){
+            ++finished_count;
+        });
+        REQUIRE(coroutine_scheduler.get_task_count() == 2, "Expected the parked and the unrun coroutines to remain.");
+    }
+    REQUIRE(finished_count == 1, "Expected the remaining coroutines to be abandoned rather than run.");
+}
+
+TEST(coroutine_scheduler, evaluation, many_sleeping_coroutines) {
+    gtl::coroutine_scheduler coroutine_scheduler;
+
+    constexpr static const unsigned long long int coroutine_count = 10000;
+
+    unsigned long long int woken = 0;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned long long int index = 0; index < coroutine_count; ++index) {
+        coroutine_scheduler.spawn(gtl::coroutine::stack_size(16 * 1024), [&woken, index](){
+            gtl::this_coroutine::sleep_for(std::chrono::milliseconds(10 + index % 10));
+            ++woken;
+        });
+    }
+    coroutine_scheduler.run();
+    const std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+
+    REQUIRE(woken == coroutine_count, "Expected %lld coroutines to wake, not %lld.", coroutine_count, woken);
+    REQUIRE(elapsed < std::chrono::seconds(5), "Expected the sleeping coroutines to share the thread rather than sleeping it in turn.");
+}
@@ -0,0 +1,109 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <benchmark.tests.hpp>
+#include <require.tests.hpp>
+
+#include <execution/coroutine_semaphore>
+
+#if defined(_MSC_VER)
+#   pragma warning(push, 0)
+#endif
+
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+
+TEST(coroutine_semaphore, traits, standard) {
+    REQUIRE(sizeof(gtl::coroutine_semaphore) >= 1, "sizeof(gtl::coroutine_semaphore) = %ld, expected >= %lld", sizeof(gtl::coroutine_semaphore), 1ull);
+
+    REQUIRE(std::is_pod<gtl::coroutine_semaphore>::value == false, "Expected std::is_pod to be false.");
+
+    REQUIRE(std::is_trivial<gtl::coroutine_semaphore>::value == false, "Expected std::is_trivial to be false.");
+
+    REQUIRE(std::is_trivially_copyable<gtl::coroutine_semaphore>::value == false, "Expected std::is_trivially_copyable to be false.");
+}
+
+TEST(coroutine_semaphore, constructor, empty) {
+    gtl::coroutine_semaphore coroutine_semaphore;
+    REQUIRE(coroutine_semaphore.get_count() == 0, "Expected the count to be %d, not %lld.", 0, coroutine_semaphore.get_count());
+}
+
+TEST(coroutine_semaphore, constructor, count) {
+    gtl::coroutine_semaphore coroutine_semaphore(3);
+    REQUIRE(coroutine_semaphore.get_count() == 3, "Expected the count to be %d, not %lld.", 3, coroutine_semaphore.get_count());
+}
+
+TEST(coroutine_semaphore, function, try_wait) {
+    gtl::coroutine_semaphore coroutine_semaphore(2);
+    REQUIRE(coroutine_semaphore.try_wait(2) == true, "Expected to take two units.");
+    REQUIRE(coroutine_semaphore.try_wait() == false, "Expected no units to remain.");
+    coroutine_semaphore.notify();
+    REQUIRE(coroutine_semaphore.try_wait() == true, "Expected to take the notified unit.");
+}
+
+TEST(coroutine_semaphore, function, limit_concurrency) {
+    gtl::coroutine_scheduler coroutine_scheduler;
+    gtl::coroutine_semaphore coroutine_semaphore(2);
+    int inside = 0;
+    int maximum_inside = 0;
+    for (int index = 0; index < 8; ++index) {
+        coroutine_scheduler.spawn([&](){
+            coroutine_semaphore.wait();
+            ++inside;
+            maximum_inside = (inside > maximum_inside) ? inside : maximum_inside;
+            gtl::this_coroutine::yield();
+            gtl::this_coroutine::yield();
+            --inside;
+            coroutine_semaphore.notify();
+        });
+    }
+    coroutine_scheduler.run();
+    REQUIRE(maximum_inside == 2, "Expected at most two coroutines inside at once, not %d.", maximum_inside);
+    REQUIRE(coroutine_semaphore.get_count() == 2, "Expected the count to be %d, not %lld.", 2, coroutine_semaphore.get_count());
+}
+
+TEST(coroutine_semaphore, function, bulk_wait_in_order) {
+    gtl::coroutine_scheduler coroutine_scheduler;
+    gtl::coroutine_semaphore coroutine_semaphore;
+    std::vector<int> order;
+    coroutine_scheduler.spawn([&](){
+        coroutine_semaphore.wait(3);
+        order.push_back(3);
+    });
+    coroutine_scheduler.spawn([&](){
+        coroutine_semaphore.wait(1);
+        order.push_back(1);
+    });
+    coroutine_scheduler.spawn([&](){
+        // A single unit is not enough for the first waiter, and the second must wait behind it.
+        coroutine_semaphore.notify(1);
+        gtl::this_coroutine::yield();
+        REQUIRE(order.empty(), "Expected both waiters to still be parked.");
+        coroutine_semaphore.notify(3);
+    });
+    coroutine_scheduler.run();
+    REQUIRE((order == std::vector<int>{ 3, 1 }), "Expected the waiters to be served in order.");
+    REQUIRE(coroutine_semaphore.get_count() == 0, "Expected the count to be %d, not %lld.", 0, coroutine_semaphore.get_count());
+}
@@ -0,0 +1,199 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <benchmark.tests.hpp>
+#include <require.tests.hpp>
+
+#include <execution/generator>
+
+#if defined(_MSC_VER)
+#   pragma warning(push, 0)
+#endif
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+
+namespace {
+    class copy_counter final {
+    public:
+        static inline int copies = 0;
+        int value;
+        explicit copy_counter(int initial_value) : value(initial_value) {}
+        copy_counter(const copy_counter& other) : value(other.value) { ++copies; }
+        copy_counter& operator=(const copy_counter& other) { value = other.value; ++copies; return *this; }
+    };
+
+    gtl::generator<int> make_range(int begin, int end) {
+        return gtl::generator<int>([](gtl::generator<int>::yielder& yield, int first, int last){
+            for (int value = first; value < last; ++value) {
+                if (!yield(value)) {
+                    return;
+                }
+            }
+        }, begin, end);
+    }
+}
+
+TEST(generator, traits, standard) {
+    REQUIRE(sizeof(gtl::generator<int>) >= 1, "sizeof(gtl::generator<int>) = %ld, expected >= %lld", sizeof(gtl::generator<int>), 1ull);
+
+    REQUIRE(std::is_pod<gtl::generator<int>>::value == false, "Expected std::is_pod to be false.");
+
+    REQUIRE(std::is_trivial<gtl::generator<int>>::value == false, "Expected std::is_trivial to be false.");
+
+    REQUIRE(std::is_trivially_copyable<gtl::generator<int>>::value == false, "Expected std::is_trivially_copyable to be false.");
+
+    REQUIRE(std::is_move_constructible<gtl::generator<int>>::value == false, "Expected std::is_move_constructible to be false.");
+}
+
+TEST(generator, constructor, lambda) {
+    gtl::generator<int> generator([](gtl::generator<int>::yielder&){});
+    testbench::do_not_optimise_away(generator);
+}
+
+TEST(generator, constructor, stack_size_lambda_argument) {
+    gtl::generator<int> generator(gtl::coroutine::stack_size(16 * 1024), [](gtl::generator<int>::yielder& yield, int value){ yield(value); }, 1);
+    REQUIRE(generator.next() == true, "Expected the generator to yield a value.");
+    REQUIRE(generator.value() == 1, "Expected the generator to yield 1, not %d.", generator.value());
+    REQUIRE(generator.next() == false, "Expected the generator to be finished.");
+}
+
+TEST(generator, constructor, move_only_lambda_argument) {
+    std::unique_ptr<int> owned_step(new int(2));
+    std::unique_ptr<int> owned_count(new int(3));
+    gtl::generator<int> generator([step = std::move(owned_step)](gtl::generator<int>::yielder& yield, std::unique_ptr<int>& count){
+        for (int index = 0; index < *count; ++index) {
+            yield(index * *step);
+        }
+    }, std::move(owned_count));
+    REQUIRE(owned_count == nullptr, "Expected the argument to be moved into the generator.");
+    for (int expected = 0; expected < 6; expected += 2) {
+        REQUIRE(generator.next() == true, "Expected the generator to yield a value.");
+        REQUIRE(generator.value() == expected, "Expected the generator to yield %d, not %d.", expected, generator.value());
+    }
+    REQUIRE(generator.next() == false, "Expected the generator to be finished.");
+}
+
+TEST(generator, function, next_and_value) {
+    gtl::generator<int> generator = make_range(0, 3);
+    for (int expected = 0; expected < 3; ++expected) {
+        REQUIRE(generator.next() == true, "Expected the generator to yield a value.");
+        REQUIRE(generator.value() == expected, "Expected the generator to yield %d, not %d.", expected, generator.value());
+    }
+    REQUIRE(generator.next() == false, "Expected the generator to be finished.");
+}
+
+TEST(generator, function, range_for) {
+    int expected = 0;
+    for (int& value : make_range(0, 100)) {
+        REQUIRE(value == expected, "Expected the generator to yield %d, not %d.", expected, value);
+        ++expected;
+    }
+    REQUIRE(expected == 100, "Expected the generator to yield %d values, not %d.", 100, expected);
+}
+
+TEST(generator, function, range_for_empty) {
+    int count = 0;
+    for (int& value : make_range(0, 0)) {
+        static_cast<void>(value);
+        ++count;
+    }
+    REQUIRE(count == 0, "Expected the generator to yield no values, not %d.", count);
+}
+
+TEST(generator, function, yield_without_copy) {
+    copy_counter::copies = 0;
+    gtl::generator<copy_counter> generator([](gtl::generator<copy_counter>::yielder& yield){
+        copy_counter counter(0);
+        for (int index = 0; index < 10; ++index) {
+            counter.value = index;
+            yield(counter);
+        }
+        yield(copy_counter(10));
+    });
+    int expected = 0;
+    for (copy_counter& counter : generator) {
+        REQUIRE(counter.value == expected, "Expected the generator to yield %d, not %d.", expected, counter.value);
+        ++expected;
+    }
+    REQUIRE(copy_counter::copies == 0, "Expected no copies of the yielded values, not %d.", copy_counter::copies);
+}
+
+TEST(generator, function, move_from_value) {
+    gtl::generator<std::string> generator([](gtl::generator<std::string>::yielder& yield){
+        std::string text = "a string that is too long for the small string optimisation";
+        yield(text);
+        yield(std::string(text.empty() ? "moved" : "copied"));
+    });
+    std::string first;
+    std::string second;
+    if (generator.next()) {
+        first = std::move(generator.value());
+    }
+    if (generator.next()) {
+        second = generator.value();
+    }
+    REQUIRE(first.size() > 0, "Expected the first value to be moved out of the generator.");
+    REQUIRE(second == "moved", "Expected the generator to see its value was moved from, not '%s'.", second.c_str());
+}
+
+TEST(generator, function, cancel_on_destruction) {
+    bool cancelled = false;
+    int last = 0;
+    {
+        gtl::generator<int> generator([&cancelled, &last](gtl::generator<int>::yielder& yield){
+            for (int value = 0; ; ++value) {
+                last = value;
+                if (!yield(value)) {
+                    cancelled = true;
+                    return;
+                }
+            }
+        });
+        for (int& value : generator) {
+            if (value == 5) {
+                break;
+            }
+        }
+    }
+    REQUIRE(cancelled == true, "Expected the generator function to be told it was cancelled.");
+    REQUIRE(last == 5, "Expected the generator function to stop at 5, not %d.", last);
+}
+
+TEST(generator, evaluation, pipeline) {
+    gtl::generator<int> squares([](gtl::generator<int>::yielder& yield){
+        for (int& value : make_range(0, 10)) {
+            if (!yield(value * value)) {
+                return;
+            }
+        }
+    });
+    int total = 0;
+    for (int& value : squares) {
+        total += value;
+    }
+    REQUIRE(total == 285, "Expected the sum of the squares to be 285, not %d.", total);
+}
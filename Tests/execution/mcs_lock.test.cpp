@@ -0,0 +1,145 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <benchmark.tests.hpp>
+#include <require.tests.hpp>
+
+#include <execution/mcs_lock>
+
+#if defined(_MSC_VER)
+#   pragma warning(push, 0)
+#endif
+
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+
+TEST(mcs_lock, traits, standard) {
+    REQUIRE(sizeof(gtl::mcs_lock) >= 1, "sizeof(gtl::mcs_lock) = %ld, expected >= %lld", sizeof(gtl::mcs_lock), 1ull);
+
+    REQUIRE(std::is_pod<gtl::mcs_lock>::value == false, "Expected std::is_pod to be false.");
+
+    REQUIRE(std::is_trivial<gtl::mcs_lock>::value == false, "Expected std::is_trivial to be false.");
+
+    REQUIRE(std::is_trivially_copyable<gtl::mcs_lock>::value == false, "Expected std::is_trivially_copyable to be false.");
+
+    REQUIRE(std::is_standard_layout<gtl::mcs_lock>::value == true, "Expected std::is_standard_layout to be true.");
+}
+
+TEST(mcs_lock, constructor, empty) {
+    gtl::mcs_lock mcs_lock;
+    testbench::do_not_optimise_away(mcs_lock);
+}
+
+TEST(mcs_lock, function, lock_and_unlock) {
+    gtl::mcs_lock mcs_lock;
+    mcs_lock.lock();
+    mcs_lock.unlock();
+}
+
+TEST(mcs_lock, function, try_lock_and_unlock) {
+    gtl::mcs_lock mcs_lock;
+    REQUIRE(mcs_lock.try_lock() == true, "Expected the newly constructed mcs_lock to be lockable.");
+    REQUIRE(mcs_lock.try_lock() == false, "Expected the locked mcs_lock to not be lockable.");
+    mcs_lock.unlock();
+}
+
+TEST(mcs_lock, evaluation, lock_guard) {
+    gtl::mcs_lock mcs_lock;
+    {
+        std::lock_guard<gtl::mcs_lock> lock_guard(mcs_lock);
+        testbench::do_not_optimise_away(lock_guard);
+        REQUIRE(mcs_lock.try_lock() == false, "Expected the newly constructed lock_guard to lock the mcs_lock.");
+    }
+    REQUIRE(mcs_lock.try_lock() == true, "Expected the destructed lock_guard to unlock the mcs_lock.");
+    mcs_lock.unlock();
+}
+
+TEST(mcs_lock, evaluation, unique_lock) {
+    gtl::mcs_lock mcs_lock;
+    {
+        std::unique_lock<gtl::mcs_lock> unique_lock(mcs_lock);
+        testbench::do_not_optimise_away(unique_lock);
+        REQUIRE(mcs_lock.try_lock() == false, "Expected the newly constructed unique_lock to lock the mcs_lock.");
+        unique_lock.unlock();
+        REQUIRE(mcs_lock.try_lock() == true, "Expected the unique_lock be unlockable.");
+        mcs_lock.unlock();
+    }
+    REQUIRE(mcs_lock.try_lock() == true, "Expected the destructed unique_lock to unlock the mcs_lock.");
+    mcs_lock.unlock();
+}
+
+TEST(mcs_lock, evaluation, multiple_locks) {
+    gtl::mcs_lock mcs_lock1;
+    gtl::mcs_lock mcs_lock2;
+    mcs_lock1.lock();
+    mcs_lock2.lock();
+    mcs_lock1.unlock();
+    REQUIRE(mcs_lock1.try_lock() == true, "Expected the first mcs_lock to be lockable while the second is held.");
+    mcs_lock2.unlock();
+    mcs_lock1.unlock();
+}
+
+TEST(mcs_lock, evaluation, more_locks_than_nodes) {
+    constexpr static const unsigned long long int lock_count = gtl::mcs_lock::nodes_per_thread * 2;
+    gtl::mcs_lock mcs_locks[lock_count];
+    for (unsigned long long int index = 0; index < lock_count; ++index) {
+        mcs_locks[index].lock();
+    }
+    for (unsigned long long int index = 0; index < lock_count; ++index) {
+        REQUIRE(mcs_locks[index].try_lock() == false, "Expected mcs_lock %llu to be held.", index);
+    }
+    for (unsigned long long int index = lock_count; index > 0; --index) {
+        mcs_locks[index - 1].unlock();
+    }
+    for (unsigned long long int index = 0; index < lock_count; ++index) {
+        REQUIRE(mcs_locks[index].try_lock() == true, "Expected mcs_lock %llu to be unlocked.", index);
+        mcs_locks[index].unlock();
+    }
+}
+
+TEST(mcs_lock, evaluation, threaded_counter) {
+    gtl::mcs_lock mcs_lock;
+    unsigned long long int counter = 0;
+
+    constexpr static const unsigned long long int thread_count = 4;
+    constexpr static const unsigned long long int iteration_count = 10000;
+
+    std::vector<std::thread> threads;
+    for (unsigned long long int thread_index = 0; thread_index < thread_count; ++thread_index) {
+        threads.emplace_back([&mcs_lock, &counter](){
+            for (unsigned long long int iteration = 0; iteration < iteration_count; ++iteration) {
+                std::lock_guard<gtl::mcs_lock> lock_guard(mcs_lock);
+                ++counter;
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(counter == thread_count * iteration_count, "Expected the counter to be %lld, not %lld.", thread_count * iteration_count, counter);
+}
@@ -0,0 +1,237 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <benchmark.tests.hpp>
+#include <require.tests.hpp>
+
+#include <execution/reactor>
+
+#if defined(linux) || defined(__linux) || defined(__linux__)
+
+#include <chrono>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+    class pipe_pair final {
+    public:
+        int descriptors[2];
+
+    public:
+        ~pipe_pair() {
+            close(this->descriptors[0]);
+            close(this->descriptors[1]);
+        }
+
+        explicit pipe_pair(bool use_socket) {
+            if (use_socket) {
+                REQUIRE(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, this->descriptors) == 0, "Failed to create a socket pair.");
+            }
+            else {
+                REQUIRE(pipe2(this->descriptors, O_NONBLOCK) == 0, "Failed to create a pipe.");
+            }
+        }
+
+        pipe_pair(const pipe_pair&) = delete;
+        pipe_pair(pipe_pair&&) = delete;
+        pipe_pair& operator=(const pipe_pair&) = delete;
+        pipe_pair& operator=(pipe_pair&&) = delete;
+    };
+}
+
+TEST(reactor, traits, standard) {
+    REQUIRE(sizeof(gtl::reactor) >= 1, "sizeof(gtl::reactor) = %ld, expected >= %lld", sizeof(gtl::reactor), 1ull);
+
+    REQUIRE(std::is_pod<gtl::reactor>::value == false, "Expected std::is_pod to be false.");
+
+    REQUIRE(std::is_trivial<gtl::reactor>::value == false, "Expected std::is_trivial to be false.");
+
+    REQUIRE(std::is_trivially_copyable<gtl::reactor>::value == false, "Expected std::is_trivially_copyable to be false.");
+}
+
+TEST(reactor, constructor, empty) {
+    gtl::coroutine_scheduler coroutine_scheduler;
+    for (bool allow_io_uring : { false, true }) {
+        gtl::reactor reactor(coroutine_scheduler, allow_io_uring);
+        if (!allow_io_uring) {
+            REQUIRE(reactor.is_using_io_uring() == false, "Expected the epoll backend when io_uring is not allowed.");
+        }
+        REQUIRE(reactor.get_waiting_count() == 0, "Expected the waiting count to be %d, not %lld.", 0, reactor.get_waiting_count());
+        testbench::do_not_optimise_away(reactor);
+    }
+}
+
+TEST(reactor, function, read_after_write) {
+    for (bool allow_io_uring : { false, true }) {
+        for (bool use_socket : { false, true }) {
+            gtl::coroutine_scheduler coroutine_scheduler;
+            gtl::reactor reactor(coroutine_scheduler, allow_io_uring);
+            pipe_pair pipe(use_socket);
+            std::vector<int> order;
+            char received[6] = {};
+            long long int read_result = 0;
+            coroutine_scheduler.spawn([&](){
+                order.push_back(1);
+                read_result = reactor.read(pipe.descriptors[0], received, 5);
+                order.push_back(3);
+            });
+            coroutine_scheduler.spawn([&](){
+                order.push_back(2);
+                REQUIRE(reactor.write(pipe.descriptors[1], "hello", 5) == 5, "Expected to write 5 bytes.");
+            });
+            coroutine_scheduler.run();
+            REQUIRE(read_result == 5, "Expected to read %d bytes, not %lld.", 5, read_result);
+            REQUIRE(std::string(received) == "hello", "Expected to read 'hello', not '%s'.", received);
+            REQUIRE((order == std::vector<int>{ 1, 2, 3 }), "Expected the reader to wait for the writer.");
+            REQUIRE(reactor.get_waiting_count() == 0, "Expected the waiting count to be %d, not %lld.", 0, reactor.get_waiting_count());
+        }
+    }
+}
+
+TEST(reactor, function, await) {
+    for (bool allow_io_uring : { false, true }) {
+        gtl::coroutine_scheduler coroutine_scheduler;
+        gtl::reactor reactor(coroutine_scheduler, allow_io_uring);
+        pipe_pair pipe(true);
+        unsigned int readable_events = 0;
+        unsigned int writable_events = 0;
+        coroutine_scheduler.spawn([&](){
+            readable_events = reactor.await(pipe.descriptors[0], gtl::reactor::readable);
+        });
+        coroutine_scheduler.spawn([&](){
+            writable_events = reactor.await(pipe.descriptors[1], gtl::reactor::writable);
+            char value = 1;
+            REQUIRE(::write(pipe.descriptors[1], &value, 1) == 1, "Expected to write 1 byte.");
+        });
+        coroutine_scheduler.run();
+        REQUIRE((readable_events & gtl::reactor::readable) != 0, "Expected the socket to become readable.");
+        REQUIRE((writable_events & gtl::reactor::writable) != 0, "Expected the socket to be writable.");
+    }
+}
+
+TEST(reactor, function, await_combined) {
+    for (bool allow_io_uring : { false, true }) {
+        gtl::coroutine_scheduler coroutine_scheduler;
+        gtl::reactor reactor(coroutine_scheduler, allow_io_uring);
+        pipe_pair pipe(true);
+        unsigned int combined_events = 0;
+        unsigned int readable_events = 0;
+        coroutine_scheduler.spawn([&](){
+            // An empty socket is only writable, which must release the waiter from both slots.
+            combined_events = reactor.await(pipe.descriptors[0], gtl::reactor::readable | gtl::reactor::writable);
+            readable_events = reactor.await(pipe.descriptors[0], gtl::reactor::readable);
+        });
+        coroutine_scheduler.spawn([&](){
+            // Write once the combined wait has been satisfied by the writable event alone.
+            gtl::this_coroutine::sleep_for(std::chrono::milliseconds(10));
+            char value = 1;
+            REQUIRE(::write(pipe.descriptors[1], &value, 1) == 1, "Expected to write 1 byte.");
+        });
+        coroutine_scheduler.run();
+        REQUIRE((combined_events & gtl::reactor::readable) == 0, "Expected the socket to only be writable.");
+        REQUIRE((combined_events & gtl::reactor::writable) != 0, "Expected the socket to be writable.");
+        REQUIRE((readable_events & gtl::reactor::readable) != 0, "Expected the socket to become readable.");
+        REQUIRE(reactor.get_waiting_count() == 0, "Expected the waiting count to be %d, not %lld.", 0, reactor.get_waiting_count());
+    }
+}
+
+TEST(reactor, function, end_of_file) {
+    for (bool allow_io_uring : { false, true }) {
+        gtl::coroutine_scheduler coroutine_scheduler;
+        gtl::reactor reactor(coroutine_scheduler, allow_io_uring);
+        int descriptors[2];
+        REQUIRE(pipe2(descriptors, O_NONBLOCK) == 0, "Failed to create a pipe.");
+        long long int read_result = -1;
+        coroutine_scheduler.spawn([&](){
+            char buffer[4];
+            read_result = reactor.read(descriptors[0], buffer, sizeof(buffer));
+        });
+        coroutine_scheduler.spawn([&](){
+            close(descriptors[1]);
+        });
+        coroutine_scheduler.run();
+        close(descriptors[0]);
+        REQUIRE(read_result == 0, "Expected the read to reach the end of the file, not return %lld.", read_result);
+    }
+}
+
+TEST(reactor, function, sleep_and_read) {
+    for (bool allow_io_uring : { false, true }) {
+        gtl::coroutine_scheduler coroutine_scheduler;
+        gtl::reactor reactor(coroutine_scheduler, allow_io_uring);
+        pipe_pair pipe(false);
+        std::vector<int> order;
+        coroutine_scheduler.spawn([&](){
+            char value = 0;
+            REQUIRE(reactor.read(pipe.descriptors[0], &value, 1) == 1, "Expected to read 1 byte.");
+            order.push_back(value);
+        });
+        coroutine_scheduler.spawn([&](){
+            gtl::this_coroutine::sleep_for(std::chrono::milliseconds(20));
+            order.push_back(1);
+            char value = 2;
+            REQUIRE(reactor.write(pipe.descriptors[1], &value, 1) == 1, "Expected to write 1 byte.");
+        });
+        coroutine_scheduler.spawn([&](){
+            gtl::this_coroutine::sleep_for(std::chrono::milliseconds(10));
+            order.push_back(0);
+        });
+        coroutine_scheduler.run();
+        REQUIRE((order == std::vector<int>{ 0, 1, 2 }), "Expected the sleeping coroutines to wake while the reader waits.");
+    }
+}
+
+TEST(reactor, evaluation, ping_pong) {
+    constexpr static const int exchange_count = 10000;
+    for (bool allow_io_uring : { false, true }) {
+        gtl::coroutine_scheduler coroutine_scheduler;
+        gtl::reactor reactor(coroutine_scheduler, allow_io_uring);
+        pipe_pair pipe(true);
+        int pings = 0;
+        int pongs = 0;
+        coroutine_scheduler.spawn([&](){
+            for (int exchange = 0; exchange < exchange_count; ++exchange) {
+                char value = 0;
+                REQUIRE(reactor.write(pipe.descriptors[0], &value, 1) == 1, "Expected to write 1 byte.");
+                REQUIRE(reactor.read(pipe.descriptors[0], &value, 1) == 1, "Expected to read 1 byte.");
+                ++pings;
+            }
+        });
+        coroutine_scheduler.spawn([&](){
+            for (int exchange = 0; exchange < exchange_count; ++exchange) {
+                char value = 0;
+                REQUIRE(reactor.read(pipe.descriptors[1], &value, 1) == 1, "Expected to read 1 byte.");
+                REQUIRE(reactor.write(pipe.descriptors[1], &value, 1) == 1, "Expected to write 1 byte.");
+                ++pongs;
+            }
+        });
+        coroutine_scheduler.run();
+        REQUIRE(pings == exchange_count, "Expected %d pings, not %d.", exchange_count, pings);
+        REQUIRE(pongs == exchange_count, "Expected %d pongs, not %d.", exchange_count, pongs);
+    }
+}
+
+#endif
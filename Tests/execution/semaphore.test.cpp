@@ -28,9 +28,13 @@ THE SOFTWARE
 #   pragma warning(push, 0)
 #endif
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 #if defined(_MSC_VER)
 #   pragma warning(pop)
@@ -74,6 +78,26 @@ TEST(semaphore, function, notify_and_wait) {
     semaphore.wait();
 }
 
+TEST(semaphore, function, notify_and_wait_many) {
+    gtl::semaphore<std::mutex, std::condition_variable> semaphore;
+    semaphore.notify(3);
+    REQUIRE(semaphore.try_wait(4) == false, "Expected try_wait to fail when taking more than the semaphore's count.");
+    semaphore.wait(2);
+    REQUIRE(semaphore.try_wait(1) == true, "Expected try_wait to take the last unit of the semaphore's count.");
+}
+
+TEST(semaphore, function, wait_for) {
+    gtl::semaphore<std::mutex, std::condition_variable> semaphore(1);
+    REQUIRE(semaphore.wait_for(std::chrono::milliseconds(1)) == true, "Expected wait_for to succeed on a semaphore with count 1.");
+    REQUIRE(semaphore.wait_for(std::chrono::milliseconds(1)) == false, "Expected wait_for to time out on a semaphore with count 0.");
+}
+
+TEST(semaphore, function, wait_until) {
+    gtl::semaphore<std::mutex, std::condition_variable> semaphore(2);
+    REQUIRE(semaphore.wait_until(std::chrono::steady_clock::now() + std::chrono::milliseconds(1), 3) == false, "Expected wait_until to time out when taking more than the semaphore's count.");
+    REQUIRE(semaphore.try_wait(2) == true, "Expected a timed out wait_until to leave the semaphore's count unchanged.");
+}
+
 TEST(semaphore, evaluation, mutex_and_condition_variable) {
     gtl::semaphore<std::mutex, std::condition_variable> semaphore;
     testbench::do_not_optimise_away(semaphore);
@@ -83,3 +107,69 @@ TEST(semaphore, evaluation, recursive_mutex_and_condition_variable_any) {
     gtl::semaphore<std::recursive_mutex, std::condition_variable_any> semaphore;
     testbench::do_not_optimise_away(semaphore);
 }
+
+TEST(semaphore, evaluation, producer_and_consumers) {
+    gtl::semaphore<std::mutex, std::condition_variable> semaphore;
+
+    constexpr static const unsigned long long int thread_count = 4;
+    constexpr static const unsigned long long int iteration_count = 10000;
+
+    std::atomic<unsigned long long int> consumed = 0;
+
+    std::vector<std::thread> threads;
+    for (unsigned long long int thread_index = 0; thread_index < thread_count; ++thread_index) {
+        threads.emplace_back([&semaphore, &consumed](){
+            for (unsigned long long int iteration = 0; iteration < iteration_count; ++iteration) {
+                semaphore.wait();
+                ++consumed;
+            }
+        });
+    }
+
+    for (unsigned long long int iteration = 0; iteration < thread_count * iteration_count; ++iteration) {
+        semaphore.notify();
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(consumed == thread_count * iteration_count, "Expected %lld notifications to be consumed, not %lld.", thread_count * iteration_count, consumed.load());
+    REQUIRE(semaphore.try_wait() == false, "Expected try_wait to fail once every notification is consumed.");
+}
+
+TEST(semaphore, evaluation, bulk_notify_and_timed_waits) {
+    gtl::semaphore<std::mutex, std::condition_variable> semaphore;
+
+    constexpr static const unsigned long long int thread_count = 4;
+    constexpr static const unsigned long long int iteration_count = 1000;
+
+    std::atomic<unsigned long long int> consumed = 0;
+
+    std::vector<std::thread> threads;
+    for (unsigned long long int thread_index = 0; thread_index < thread_count; ++thread_index) {
+        threads.emplace_back([&semaphore, &consumed, thread_index](){
+            for (unsigned long long int iteration = 0; iteration < iteration_count; ++iteration) {
+                if (thread_index % 2) {
+                    while (!semaphore.wait_for(std::chrono::microseconds(10), 2)) {
+                    }
+                }
+                else {
+                    semaphore.wait(2);
+                }
+                consumed += 2;
+            }
+        });
+    }
+
+    for (unsigned long long int iteration = 0; iteration < thread_count * iteration_count; ++iteration) {
+        semaphore.notify(2);
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(consumed == 2 * thread_count * iteration_count, "Expected %lld notifications to be consumed, not %lld.", 2 * thread_count * iteration_count, consumed.load());
+    REQUIRE(semaphore.try_wait() == false, "Expected try_wait to fail once every notification is consumed.");
+}
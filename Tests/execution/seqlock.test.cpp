@@ -0,0 +1,123 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <benchmark.tests.hpp>
+#include <require.tests.hpp>
+#include <template.tests.hpp>
+
+#include <execution/seqlock>
+
+#if defined(_MSC_VER)
+#   pragma warning(push, 0)
+#endif
+
+#include <atomic>
+#include <thread>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+
+namespace {
+    struct triple final {
+        unsigned long long int x;
+        unsigned long long int y;
+        unsigned long long int z;
+    };
+}
+
+TEST(seqlock, traits, standard) {
+    testbench::test_template<testbench::test_types>(
+        [](auto test_type)->void {
+            using type = typename decltype(test_type)::type;
+
+            REQUIRE(sizeof(gtl::seqlock<type>) >= sizeof(type), "sizeof(gtl::seqlock<type>) = %ld, expected >= %ld", sizeof(gtl::seqlock<type>), sizeof(type));
+
+            REQUIRE(std::is_pod<gtl::seqlock<type>>::value == false, "Expected std::is_pod to be false.");
+
+            REQUIRE(std::is_trivial<gtl::seqlock<type>>::value == false, "Expected std::is_trivial to be false.");
+
+            REQUIRE(std::is_trivially_copyable<gtl::seqlock<type>>::value == false, "Expected std::is_trivially_copyable to be false.");
+
+            REQUIRE(std::is_standard_layout<gtl::seqlock<type>>::value == true, "Expected std::is_standard_layout to be true.");
+        }
+    );
+}
+
+TEST(seqlock, constructor, empty) {
+    gtl::seqlock<int> seqlock;
+    testbench::do_not_optimise_away(seqlock);
+    REQUIRE(seqlock.load() == 0, "Expected the default constructed value to be zero.");
+}
+
+TEST(seqlock, constructor, value) {
+    gtl::seqlock<int> seqlock(123);
+    REQUIRE(seqlock.load() == 123, "Expected the constructed value to be %d, not %d.", 123, seqlock.load());
+}
+
+TEST(seqlock, function, store_and_load) {
+    gtl::seqlock<triple> seqlock;
+    seqlock.store(triple{ 1, 2, 3 });
+    const triple value = seqlock.load();
+    REQUIRE(value.x == 1 && value.y == 2 && value.z == 3, "Expected the loaded value to be {1, 2, 3}, not {%lld, %lld, %lld}.", value.x, value.y, value.z);
+}
+
+TEST(seqlock, function, try_load) {
+    gtl::seqlock<char> seqlock('a');
+    char value = 0;
+    REQUIRE(seqlock.try_load(value) == true, "Expected try_load to succeed without a concurrent write.");
+    REQUIRE(value == 'a', "Expected the loaded value to be '%c', not '%c'.", 'a', value);
+}
+
+TEST(seqlock, evaluation, threaded_reader_and_writer) {
+    gtl::seqlock<triple> seqlock(triple{ 0, 0, 0 });
+    std::atomic<bool> running = true;
+
+    constexpr static const unsigned long long int iteration_count = 100000;
+
+    std::thread writer([&seqlock, &running](){
+        for (unsigned long long int iteration = 1; iteration <= iteration_count; ++iteration) {
+            seqlock.store(triple{ iteration, iteration * 2, iteration * 3 });
+        }
+        running = false;
+    });
+
+    unsigned long long int torn_reads = 0;
+    unsigned long long int last_value = 0;
+    unsigned long long int out_of_order_reads = 0;
+    while (running) {
+        const triple value = seqlock.load();
+        if ((value.y != value.x * 2) || (value.z != value.x * 3)) {
+            ++torn_reads;
+        }
+        if (value.x < last_value) {
+            ++out_of_order_reads;
+        }
+        last_value = value.x;
+    }
+
+    writer.join();
+
+    REQUIRE(torn_reads == 0, "Expected no reads to observe a partial write, not %lld.", torn_reads);
+    REQUIRE(out_of_order_reads == 0, "Expected reads to observe writes in order, not %lld out of order.", out_of_order_reads);
+    REQUIRE(seqlock.load().x == iteration_count, "Expected the final value to be %lld, not %lld.", iteration_count, seqlock.load().x);
+}
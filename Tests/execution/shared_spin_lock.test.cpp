@@ -0,0 +1,173 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <benchmark.tests.hpp>
+#include <require.tests.hpp>
+
+#include <execution/shared_spin_lock>
+
+#if defined(_MSC_VER)
+#   pragma warning(push, 0)
+#endif
+
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+
+TEST(shared_spin_lock, traits, standard) {
+    REQUIRE(sizeof(gtl::shared_spin_lock) >= 1, "sizeof(gtl::shared_spin_lock) = %ld, expected >= %lld", sizeof(gtl::shared_spin_lock), 1ull);
+
+    REQUIRE(std::is_pod<gtl::shared_spin_lock>::value == false, "Expected std::is_pod to be false.");
+
+    REQUIRE(std::is_trivial<gtl::shared_spin_lock>::value == false, "Expected std::is_trivial to be false.");
+
+    REQUIRE(std::is_trivially_copyable<gtl::shared_spin_lock>::value == false, "Expected std::is_trivially_copyable to be false.");
+
+    REQUIRE(std::is_standard_layout<gtl::shared_spin_lock>::value == true, "Expected std::is_standard_layout to be true.");
+}
+
+TEST(shared_spin_lock, constructor, empty) {
+    gtl::shared_spin_lock shared_spin_lock;
+    testbench::do_not_optimise_away(shared_spin_lock);
+}
+
+TEST(shared_spin_lock, function, lock_and_unlock) {
+    gtl::shared_spin_lock shared_spin_lock;
+    shared_spin_lock.lock();
+    shared_spin_lock.unlock();
+}
+
+TEST(shared_spin_lock, function, try_lock_and_unlock) {
+    gtl::shared_spin_lock shared_spin_lock;
+    REQUIRE(shared_spin_lock.try_lock() == true, "Expected the newly constructed shared_spin_lock to be lockable.");
+    REQUIRE(shared_spin_lock.try_lock() == false, "Expected the locked shared_spin_lock to not be lockable.");
+    REQUIRE(shared_spin_lock.try_lock_shared() == false, "Expected the locked shared_spin_lock to not be shared lockable.");
+    shared_spin_lock.unlock();
+}
+
+TEST(shared_spin_lock, function, lock_shared_and_unlock_shared) {
+    gtl::shared_spin_lock shared_spin_lock;
+    shared_spin_lock.lock_shared();
+    shared_spin_lock.lock_shared();
+    shared_spin_lock.unlock_shared();
+    shared_spin_lock.unlock_shared();
+}
+
+TEST(shared_spin_lock, function, try_lock_shared_and_unlock_shared) {
+    gtl::shared_spin_lock shared_spin_lock;
+    REQUIRE(shared_spin_lock.try_lock_shared() == true, "Expected the newly constructed shared_spin_lock to be shared lockable.");
+    REQUIRE(shared_spin_lock.try_lock_shared() == true, "Expected the shared locked shared_spin_lock to be shared lockable.");
+    REQUIRE(shared_spin_lock.try_lock() == false, "Expected the shared locked shared_spin_lock to not be lockable.");
+    shared_spin_lock.unlock_shared();
+    shared_spin_lock.unlock_shared();
+    REQUIRE(shared_spin_lock.try_lock() == true, "Expected the shared unlocked shared_spin_lock to be lockable.");
+    shared_spin_lock.unlock();
+}
+
+TEST(shared_spin_lock, evaluation, lock_guard) {
+    gtl::shared_spin_lock shared_spin_lock;
+    {
+        std::lock_guard<gtl::shared_spin_lock> lock_guard(shared_spin_lock);
+        testbench::do_not_optimise_away(lock_guard);
+        REQUIRE(shared_spin_lock.try_lock_shared() == false, "Expected the newly constructed lock_guard to lock the shared_spin_lock.");
+    }
+    REQUIRE(shared_spin_lock.try_lock() == true, "Expected the destructed lock_guard to unlock the shared_spin_lock.");
+    shared_spin_lock.unlock();
+}
+
+TEST(shared_spin_lock, evaluation, shared_lock) {
+    gtl::shared_spin_lock shared_spin_lock;
+    {
+        std::shared_lock<gtl::shared_spin_lock> shared_lock1(shared_spin_lock);
+        std::shared_lock<gtl::shared_spin_lock> shared_lock2(shared_spin_lock);
+        testbench::do_not_optimise_away(shared_lock1);
+        testbench::do_not_optimise_away(shared_lock2);
+        REQUIRE(shared_spin_lock.try_lock() == false, "Expected the newly constructed shared_locks to shared lock the shared_spin_lock.");
+    }
+    REQUIRE(shared_spin_lock.try_lock() == true, "Expected the destructed shared_locks to unlock the shared_spin_lock.");
+    shared_spin_lock.unlock();
+}
+
+TEST(shared_spin_lock, evaluation, writer_preference) {
+    gtl::shared_spin_lock shared_spin_lock;
+    std::atomic<bool> writer_finished = false;
+
+    shared_spin_lock.lock_shared();
+
+    std::thread writer([&shared_spin_lock, &writer_finished](){
+        shared_spin_lock.lock();
+        writer_finished = true;
+        shared_spin_lock.unlock();
+    });
+
+    // Wait until the writer has announced itself, after which new readers must be refused.
+    while (shared_spin_lock.try_lock_shared()) {
+        shared_spin_lock.unlock_shared();
+        std::this_thread::yield();
+    }
+
+    REQUIRE(writer_finished == false, "Expected the writer to wait for the reader.");
+
+    shared_spin_lock.unlock_shared();
+    writer.join();
+
+    REQUIRE(writer_finished == true, "Expected the writer to take the lock once the reader released it.");
+}
+
+TEST(shared_spin_lock, evaluation, threaded_readers_and_writers) {
+    gtl::shared_spin_lock shared_spin_lock;
+    unsigned long long int values[2] = { 0, 0 };
+    std::atomic<unsigned long long int> torn_reads = 0;
+
+    constexpr static const unsigned long long int thread_count = 2;
+    constexpr static const unsigned long long int iteration_count = 10000;
+
+    std::vector<std::thread> threads;
+    for (unsigned long long int thread_index = 0; thread_index < thread_count; ++thread_index) {
+        threads.emplace_back([&shared_spin_lock, &values](){
+            for (unsigned long long int iteration = 0; iteration < iteration_count; ++iteration) {
+                std::lock_guard<gtl::shared_spin_lock> lock_guard(shared_spin_lock);
+                ++values[0];
+                ++values[1];
+            }
+        });
+        threads.emplace_back([&shared_spin_lock, &values, &torn_reads](){
+            for (unsigned long long int iteration = 0; iteration < iteration_count; ++iteration) {
+                std::shared_lock<gtl::shared_spin_lock> shared_lock(shared_spin_lock);
+                if (values[0] != values[1]) {
+                    ++torn_reads;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(torn_reads == 0, "Expected no readers to observe a partial write, not %lld.", torn_reads.load());
+    REQUIRE(values[0] == thread_count * iteration_count, "Expected the value to be %lld, not %lld.", thread_count * iteration_count, values[0]);
+}
@@ -166,6 +166,32 @@ TEST(thread_pool, function, drain) {
     }
 }
 
+TEST(thread_pool, function, equal_priority) {
+    gtl::thread_pool thread_pool(0);
+
+    // A queue with pending tasks must survive another queue of the same priority being drained and destroyed.
+    gtl::thread_pool::queue queue(thread_pool);
+    bool flag = false;
+    queue.push([&flag](){
+        flag = true;
+    });
+
+    bool temporary_flag = false;
+    {
+        gtl::thread_pool::queue temporary_queue(thread_pool);
+        temporary_queue.push([&temporary_flag](){
+            temporary_flag = true;
+        });
+        temporary_queue.drain();
+    }
+    REQUIRE(temporary_flag, "Expected the temporary queue to be processed.");
+
+    // Joining only processes the queues the pool holds.
+    thread_pool.join();
+    REQUIRE(flag, "Expected the remaining queue to be processed.");
+    REQUIRE(queue.finished(), "Expected the remaining queue to be finished.");
+}
+
 TEST(thread_pool, function, joinable) {
     {
         gtl::thread_pool thread_pool = gtl::thread_pool(0);
@@ -0,0 +1,127 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <benchmark.tests.hpp>
+#include <require.tests.hpp>
+
+#include <execution/ticket_lock>
+
+#if defined(_MSC_VER)
+#   pragma warning(push, 0)
+#endif
+
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+
+TEST(ticket_lock, traits, standard) {
+    REQUIRE(sizeof(gtl::ticket_lock) >= 1, "sizeof(gtl::ticket_lock) = %ld, expected >= %lld", sizeof(gtl::ticket_lock), 1ull);
+
+    REQUIRE(std::is_pod<gtl::ticket_lock>::value == false, "Expected std::is_pod to be false.");
+
+    REQUIRE(std::is_trivial<gtl::ticket_lock>::value == false, "Expected std::is_trivial to be false.");
+
+    REQUIRE(std::is_trivially_copyable<gtl::ticket_lock>::value == false, "Expected std::is_trivially_copyable to be false.");
+
+    REQUIRE(std::is_standard_layout<gtl::ticket_lock>::value == true, "Expected std::is_standard_layout to be true.");
+}
+
+TEST(ticket_lock, constructor, empty) {
+    gtl::ticket_lock ticket_lock;
+    testbench::do_not_optimise_away(ticket_lock);
+}
+
+TEST(ticket_lock, function, lock_and_unlock) {
+    gtl::ticket_lock ticket_lock;
+    ticket_lock.lock();
+    ticket_lock.unlock();
+}
+
+TEST(ticket_lock, function, try_lock_and_unlock) {
+    gtl::ticket_lock ticket_lock;
+    REQUIRE(ticket_lock.try_lock() == true, "Expected the newly constructed ticket_lock to be lockable.");
+    REQUIRE(ticket_lock.try_lock() == false, "Expected the locked ticket_lock to not be lockable.");
+    ticket_lock.unlock();
+}
+
+TEST(ticket_lock, evaluation, lock_guard) {
+    gtl::ticket_lock ticket_lock;
+    {
+        std::lock_guard<gtl::ticket_lock> lock_guard(ticket_lock);
+        testbench::do_not_optimise_away(lock_guard);
+        REQUIRE(ticket_lock.try_lock() == false, "Expected the newly constructed lock_guard to lock the ticket_lock.");
+    }
+    REQUIRE(ticket_lock.try_lock() == true, "Expected the destructed lock_guard to unlock the ticket_lock.");
+    ticket_lock.unlock();
+}
+
+TEST(ticket_lock, evaluation, unique_lock) {
+    gtl::ticket_lock ticket_lock;
+    {
+        std::unique_lock<gtl::ticket_lock> unique_lock(ticket_lock);
+        testbench::do_not_optimise_away(unique_lock);
+        REQUIRE(ticket_lock.try_lock() == false, "Expected the newly constructed unique_lock to lock the ticket_lock.");
+        unique_lock.unlock();
+        REQUIRE(ticket_lock.try_lock() == true, "Expected the unique_lock be unlockable.");
+        ticket_lock.unlock();
+    }
+    REQUIRE(ticket_lock.try_lock() == true, "Expected the destructed unique_lock to unlock the ticket_lock.");
+    ticket_lock.unlock();
+}
+
+TEST(ticket_lock, evaluation, multiple_locks) {
+    gtl::ticket_lock ticket_lock1;
+    gtl::ticket_lock ticket_lock2;
+    ticket_lock1.lock();
+    ticket_lock2.lock();
+    ticket_lock1.unlock();
+    REQUIRE(ticket_lock1.try_lock() == true, "Expected the first ticket_lock to be lockable while the second is held.");
+    ticket_lock2.unlock();
+    ticket_lock1.unlock();
+}
+
+TEST(ticket_lock, evaluation, threaded_counter) {
+    gtl::ticket_lock ticket_lock;
+    unsigned long long int counter = 0;
+
+    constexpr static const unsigned long long int thread_count = 4;
+    constexpr static const unsigned long long int iteration_count = 10000;
+
+    std::vector<std::thread> threads;
+    for (unsigned long long int thread_index = 0; thread_index < thread_count; ++thread_index) {
+        threads.emplace_back([&ticket_lock, &counter](){
+            for (unsigned long long int iteration = 0; iteration < iteration_count; ++iteration) {
+                std::lock_guard<gtl::ticket_lock> lock_guard(ticket_lock);
+                ++counter;
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(counter == thread_count * iteration_count, "Expected the counter to be %lld, not %lld.", thread_count * iteration_count, counter);
+}
@@ -0,0 +1,112 @@
+/*
+The MIT License
+Copyright (c) 2019 Geoffrey Daniels. http://gpdaniels.com/
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE
+*/
+
+#include <main.tests.hpp>
+#include <benchmark.tests.hpp>
+#include <require.tests.hpp>
+
+#include <execution/tree_barrier>
+
+#if defined(_MSC_VER)
+#   pragma warning(push, 0)
+#endif
+
+#include <atomic>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER)
+#   pragma warning(pop)
+#endif
+
+TEST(tree_barrier, traits, standard) {
+    REQUIRE(sizeof(gtl::tree_barrier) >= 1, "sizeof(gtl::tree_barrier) = %ld, expected >= %lld", sizeof(gtl::tree_barrier), 1ull);
+
+    REQUIRE(std::is_pod<gtl::tree_barrier>::value == false, "Expected std::is_pod to be false.");
+
+    REQUIRE(std::is_trivial<gtl::tree_barrier>::value == false, "Expected std::is_trivial to be false.");
+
+    REQUIRE(std::is_trivially_copyable<gtl::tree_barrier>::value == false, "Expected std::is_trivially_copyable to be false.");
+
+    REQUIRE(std::is_standard_layout<gtl::tree_barrier>::value == true, "Expected std::is_standard_layout to be true.");
+}
+
+TEST(tree_barrier, constructor, value) {
+    gtl::tree_barrier tree_barrier(1);
+    testbench::do_not_optimise_away(tree_barrier);
+}
+
+TEST(tree_barrier, function, get_trigger_count) {
+    gtl::tree_barrier tree_barrier(3);
+    REQUIRE(tree_barrier.get_trigger_count() == 3, "Expected the trigger count of the barrier to be %d, not %lld", 3, tree_barrier.get_trigger_count());
+}
+
+TEST(tree_barrier, function, sync) {
+    gtl::tree_barrier tree_barrier(1);
+    tree_barrier.sync();
+    tree_barrier.sync();
+}
+
+TEST(tree_barrier, function, sync_new_barriers) {
+    // Each barrier is constructed at the same address, the threads must claim new slots on each.
+    for (unsigned long long int iteration = 0; iteration < 3; ++iteration) {
+        gtl::tree_barrier tree_barrier(2);
+        std::thread thread([&tree_barrier](){
+            tree_barrier.sync();
+            tree_barrier.sync();
+        });
+        tree_barrier.sync();
+        tree_barrier.sync();
+        thread.join();
+    }
+}
+
+TEST(tree_barrier, evaluation, lockstep_phases) {
+    constexpr static const unsigned long long int thread_count = 10;
+    constexpr static const unsigned long long int phase_count = 1000;
+
+    gtl::tree_barrier tree_barrier(thread_count);
+
+    std::atomic<unsigned long long int> progress[thread_count] = {};
+    std::atomic<bool> in_lockstep = true;
+
+    std::vector<std::thread> threads;
+    for (unsigned long long int thread_index = 0; thread_index < thread_count; ++thread_index) {
+        threads.emplace_back([&tree_barrier, &progress, &in_lockstep, thread_index](){
+            for (unsigned long long int phase = 1; phase <= phase_count; ++phase) {
+                progress[thread_index].store(phase);
+                tree_barrier.sync();
+                // After the barrier every thread has reached this phase, and none can have passed the next barrier.
+                for (unsigned long long int other_index = 0; other_index < thread_count; ++other_index) {
+                    const unsigned long long int other_phase = progress[other_index].load();
+                    if ((other_phase < phase) || (other_phase > phase + 1)) {
+                        in_lockstep = false;
+                    }
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(in_lockstep == true, "Expected every thread to pass the barrier in lockstep.");
+}
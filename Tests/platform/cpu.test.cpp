@@ -95,6 +95,10 @@ TEST(cpu, function, has_xxx) {
 
     cpu.has_avx512_foundation();
 
+    cpu.has_osxsave();
+    cpu.has_os_avx_support();
+    cpu.has_os_avx512_support();
+
     cpu.has_bmi();
     cpu.has_bmi2();
 }